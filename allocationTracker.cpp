@@ -0,0 +1,85 @@
+#include "allocationTracker.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+AllocationCounts AllocationCounts::operator-(const AllocationCounts& other) const
+{
+    return {allocations - other.allocations, bytes - other.bytes, frees - other.frees};
+}
+
+#ifdef SPEEDRACER_TRACK_ALLOCATIONS
+
+static std::atomic<std::uint64_t> allocationCount{0};
+static std::atomic<std::uint64_t> allocatedBytes{0};
+static std::atomic<std::uint64_t> freeCount{0};
+
+static void* trackedAllocate(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) { throw std::bad_alloc{}; }
+    return memory;
+}
+
+static void trackedFree(void* memory)
+{
+    if (memory == nullptr) { return; }
+    freeCount.fetch_add(1, std::memory_order_relaxed);
+    std::free(memory);
+}
+
+// Over-aligned new and delete keep their default versions, nothing in the game allocates over-aligned types
+void* operator new(std::size_t size) { return trackedAllocate(size); }
+void* operator new[](std::size_t size) { return trackedAllocate(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try { return trackedAllocate(size); }
+    catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    try { return trackedAllocate(size); }
+    catch (...) { return nullptr; }
+}
+void operator delete(void* memory) noexcept { trackedFree(memory); }
+void operator delete[](void* memory) noexcept { trackedFree(memory); }
+void operator delete(void* memory, std::size_t) noexcept { trackedFree(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { trackedFree(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { trackedFree(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { trackedFree(memory); }
+
+bool AllocationTracker::enabled() { return true; }
+
+AllocationCounts AllocationTracker::counts()
+{
+    return {allocationCount.load(std::memory_order_relaxed), allocatedBytes.load(std::memory_order_relaxed),
+        freeCount.load(std::memory_order_relaxed)};
+}
+
+#else
+
+bool AllocationTracker::enabled() { return false; }
+
+AllocationCounts AllocationTracker::counts() { return {}; }
+
+#endif
+
+
+// * FrameAllocations //
+void FrameAllocations::frameStarted() { start = AllocationTracker::counts(); }
+
+void FrameAllocations::frameEnded()
+{
+    last = AllocationTracker::counts() - start;
+    frames++;
+    totalAllocations += last.allocations;
+    totalBytes += last.bytes;
+    if (last.allocations > peakAllocations) { peakAllocations = last.allocations; }
+    if (last.bytes > peakBytes) { peakBytes = last.bytes; }
+}
+
+float FrameAllocations::averageAllocations() const { return frames > 0 ? (float)totalAllocations / frames : 0.0f; }
+
+float FrameAllocations::averageBytes() const { return frames > 0 ? (float)totalBytes / frames : 0.0f; }
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+
+// * Allocation tracking //
+// Counts every heap allocation of the program when built with SPEEDRACER_TRACK_ALLOCATIONS
+// * Replaces the global operator new and delete, so allocations inside SFML and the standard library count too
+// * Without it the counts stay 0 and new/delete are untouched
+struct AllocationCounts
+{
+    std::uint64_t allocations = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t frees = 0;
+
+    AllocationCounts operator-(const AllocationCounts& other) const;
+};
+
+namespace AllocationTracker
+{
+    bool enabled();
+
+    // Since the program started, over all threads
+    AllocationCounts counts();
+}
+
+// Allocations per frame, call frameStarted() and frameEnded() around every frame
+class FrameAllocations
+{
+    public:
+        void frameStarted();
+        void frameEnded();
+
+        const AllocationCounts& lastFrame() const { return last; }
+        int frameCount() const { return frames; }
+        float averageAllocations() const;
+        float averageBytes() const;
+        std::uint64_t maxAllocations() const { return peakAllocations; }
+        std::uint64_t maxBytes() const { return peakBytes; }
+
+    private:
+        AllocationCounts start;
+        AllocationCounts last;
+        int frames = 0;
+        std::uint64_t totalAllocations = 0;
+        std::uint64_t totalBytes = 0;
+        std::uint64_t peakAllocations = 0;
+        std::uint64_t peakBytes = 0;
+};
\ No newline at end of file
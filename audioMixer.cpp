@@ -0,0 +1,301 @@
+#include "audioMixer.h"
+
+#include "myMathLib.h"
+#include "random.h"
+#include "world.h"
+
+// After myMathLib.h, some standard libraries define M_PI as a macro in <cmath>
+#include <cmath>
+#include <fstream>
+
+static constexpr float pi = 3.14159265f;
+
+AudioMixer::AudioMixer(const AudioSettings& settings) : settings(settings)
+{
+    for (int& id : engineIds) { id = -1; }
+    synthesize();
+}
+
+// * Game thread //
+void AudioMixer::update(const World& world)
+{
+    const Player* player = world.bodies.player;
+    if (player == nullptr) { return; }
+
+    // * One shots //
+    eventCursor = world.events.read(eventCursor, [&](const WorldEvent& event)
+    {
+        if (event.type == WorldEvent::Type::PLAYER_HIT)
+        {
+            send({Command::Type::ONE_SHOT, SoundId::CRASH, 0, settings.effectVolume, 0.0f, 1.0f});
+        }
+        else if (event.type == WorldEvent::Type::CAR_DODGED)
+        {
+            send({Command::Type::ONE_SHOT, SoundId::DODGE, 0, settings.effectVolume * 0.5f, 0.0f, 1.0f});
+        }
+    });
+
+
+    // * Nearest cars //
+    // Insertion into a small sorted array, the cars outside of the cull distance never get that far
+    constexpr int carSlots = AudioSettings::maxEngineVoices - 1;
+    const RigidBody* nearest[carSlots];
+    float nearestDistance[carSlots];
+    int nearestCount = 0;
+
+    float listenerX = (float)player->pos.x;
+    float listenerY = (float)player->pos.y;
+    float cullSqr = settings.cullDistance * settings.cullDistance;
+
+    for (const Car* car : world.bodies.cars)
+    {
+        float dx = (float)car->pos.x - listenerX;
+        float dy = (float)car->pos.y - listenerY;
+        float distanceSqr = dx * dx + dy * dy;
+        if (distanceSqr >= cullSqr) { continue; }
+        if (nearestCount == carSlots && distanceSqr >= nearestDistance[carSlots - 1]) { continue; }
+
+        int i = nearestCount < carSlots ? nearestCount++ : carSlots - 1;
+        for (; i > 0 && nearestDistance[i - 1] > distanceSqr; i--)
+        {
+            nearest[i] = nearest[i - 1];
+            nearestDistance[i] = nearestDistance[i - 1];
+        }
+        nearest[i] = car;
+        nearestDistance[i] = distanceSqr;
+    }
+
+
+    // * Engine slots //
+    // Slot 0 is the player, cars keep their slot while they stay near so their engine doesn't restart
+    const RigidBody* slotBodies[AudioSettings::maxEngineVoices] = {player};
+    bool placed[carSlots] = {};
+    for (int slot = 1; slot < AudioSettings::maxEngineVoices; slot++)
+    {
+        slotBodies[slot] = nullptr;
+        for (int i = 0; i < nearestCount; i++)
+        {
+            if (!placed[i] && nearest[i]->id == engineIds[slot]) { slotBodies[slot] = nearest[i]; placed[i] = true; break; }
+        }
+    }
+    for (int i = 0, slot = 1; i < nearestCount; i++)
+    {
+        if (placed[i]) { continue; }
+        while (slotBodies[slot] != nullptr) { slot++; }
+        slotBodies[slot] = nearest[i];
+    }
+
+    audibleEngines = 0;
+    float halfWidth = (float)world.windowSize.x * 0.5f;
+    for (int slot = 0; slot < AudioSettings::maxEngineVoices; slot++)
+    {
+        const RigidBody* body = slotBodies[slot];
+        engineIds[slot] = body != nullptr ? body->id : -1;
+        if (body == nullptr || world.gameOver)
+        {
+            send({Command::Type::ENGINE, SoundId::ENGINE, (std::uint8_t)slot, 0.0f, 0.0f, 1.0f});
+            continue;
+        }
+
+        float dx = (float)body->pos.x - listenerX;
+        float dy = (float)body->pos.y - listenerY;
+        float distance = std::sqrt(dx * dx + dy * dy);
+
+        // Inverse distance, faded out towards the cull distance so a car doesn't pop out of existence
+        float gain = settings.referenceDistance / MyMathLib::max(distance, settings.referenceDistance);
+        gain *= MyMathLib::clamp(1.0f - distance / settings.cullDistance, 0.0f, 1.0f);
+
+        float speed = MyMathLib::clamp((float)(body->vel.magnitude() / body->maxVelocity()), 0.0f, 1.0f);
+        float pitch = settings.enginePitchMin + (settings.enginePitchMax - settings.enginePitchMin) * speed;
+        float pan = MyMathLib::clamp(dx / halfWidth, -1.0f, 1.0f) * 0.8f;
+
+        send({Command::Type::ENGINE, SoundId::ENGINE, (std::uint8_t)slot, gain * settings.engineVolume, pan, pitch});
+        audibleEngines++;
+    }
+}
+
+// A full queue means the audio thread stopped mixing, the parameters are resent next frame anyway
+void AudioMixer::send(const Command& command)
+{
+    if (!commands.push(command)) { dropped.fetch_add(1, std::memory_order_relaxed); }
+}
+
+
+// * Audio thread //
+void AudioMixer::mix(std::int16_t* samples, std::size_t frameCount)
+{
+    const Command* command;
+    while ((command = commands.front()) != nullptr)
+    {
+        apply(*command);
+        commands.pop();
+    }
+
+    constexpr std::size_t blockSize = 256;
+    float left[blockSize];
+    float right[blockSize];
+
+    while (frameCount > 0)
+    {
+        std::size_t count = frameCount < blockSize ? frameCount : blockSize;
+        for (std::size_t i = 0; i < count; i++) { left[i] = 0.0f; right[i] = 0.0f; }
+
+        for (Voice& voice : engines) { mixVoice(voice, left, right, count); }
+        for (Voice& voice : oneShots) { mixVoice(voice, left, right, count); }
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            samples[i * 2] = (std::int16_t)(MyMathLib::clamp(left[i] * settings.masterVolume, -1.0f, 1.0f) * 32767.0f);
+            samples[i * 2 + 1] = (std::int16_t)(MyMathLib::clamp(right[i] * settings.masterVolume, -1.0f, 1.0f) * 32767.0f);
+        }
+
+        samples += count * channelCount;
+        frameCount -= count;
+    }
+}
+
+void AudioMixer::apply(const Command& command)
+{
+    const Sound* sound = &sounds[(int)command.sound];
+
+    if (command.type == Command::Type::ENGINE)
+    {
+        Voice& voice = engines[command.slot];
+        voice.sound = sound;
+        voice.targetGain = command.gain;
+        voice.pan = command.pan;
+        voice.pitch = command.pitch;
+        return;
+    }
+
+    // One shots start at full volume, a ramp would soften the hit
+    Voice& voice = oneShots[nextOneShot];
+    nextOneShot = (nextOneShot + 1) % AudioSettings::maxOneShotVoices;
+    voice.sound = sound;
+    voice.position = 0.0;
+    voice.gain = command.gain;
+    voice.targetGain = command.gain;
+    voice.pan = command.pan;
+    voice.pitch = command.pitch;
+}
+
+// Resamples the voice by its pitch (linear interpolation) and adds it to the block
+void AudioMixer::mixVoice(Voice& voice, float* left, float* right, std::size_t frameCount)
+{
+    if (voice.sound == nullptr || (voice.gain == 0.0f && voice.targetGain == 0.0f)) { return; }
+
+    const std::vector<float>& data = voice.sound->samples;
+    double length = (double)data.size();
+
+    // Constant power panning
+    float angle = (voice.pan + 1.0f) * pi * 0.25f;
+    float leftGain = std::cos(angle);
+    float rightGain = std::sin(angle);
+
+    float gainStep = (voice.targetGain - voice.gain) / (float)frameCount;
+    for (std::size_t i = 0; i < frameCount; i++)
+    {
+        std::size_t index = (std::size_t)voice.position;
+        float fraction = (float)(voice.position - (double)index);
+        std::size_t next = index + 1 < data.size() ? index + 1 : (voice.sound->looping ? 0 : index);
+        float sample = (data[index] + (data[next] - data[index]) * fraction) * voice.gain;
+
+        left[i] += sample * leftGain;
+        right[i] += sample * rightGain;
+
+        voice.gain += gainStep;
+        voice.position += voice.pitch;
+        if (voice.position >= length)
+        {
+            if (!voice.sound->looping) { voice.sound = nullptr; return; }
+            voice.position -= length;
+        }
+    }
+    voice.gain = voice.targetGain;
+}
+
+
+// * Sounds //
+void AudioMixer::synthesize()
+{
+    float rate = (float)settings.sampleRate;
+
+    // Engine: a buzzy 55 Hz tone (decaying harmonics) with every other cycle louder, like a twin cylinder firing
+    // * A whole number of cycles, so the loop point is seamless
+    Sound& engine = sounds[(int)SoundId::ENGINE];
+    int period = (int)(rate / 55.0f);
+    engine.samples.resize(period * 2);
+    engine.looping = true;
+    for (int i = 0; i < period * 2; i++)
+    {
+        float phase = 2.0f * pi * (float)i / (float)period;
+        float sample = 0.0f;
+        for (int harmonic = 1; harmonic <= 8; harmonic++) { sample += std::sin(phase * harmonic) / harmonic; }
+        engine.samples[i] = sample * (1.0f + 0.35f * std::cos(phase * 0.5f));
+    }
+
+    // Crash: low pass filtered noise with a low thump underneath, both decaying
+    Sound& crash = sounds[(int)SoundId::CRASH];
+    crash.samples.resize((std::size_t)(rate * 0.7f));
+    crash.looping = false;
+    Random random{0x5eed};
+    float filtered = 0.0f;
+    for (std::size_t i = 0; i < crash.samples.size(); i++)
+    {
+        float time = (float)i / rate;
+        filtered += (random.range(-1.0f, 1.0f) - filtered) * (0.5f - 0.4f * time / 0.7f);
+        float thump = std::sin(2.0f * pi * 60.0f * time) * std::exp(-time * 12.0f);
+        crash.samples[i] = filtered * std::exp(-time * 5.0f) + thump;
+    }
+
+    // Dodge: a short rising whoosh
+    Sound& dodge = sounds[(int)SoundId::DODGE];
+    dodge.samples.resize((std::size_t)(rate * 0.18f));
+    dodge.looping = false;
+    float phase = 0.0f;
+    for (std::size_t i = 0; i < dodge.samples.size(); i++)
+    {
+        float progress = (float)i / (float)dodge.samples.size();
+        phase += 2.0f * pi * (700.0f + 700.0f * progress) / rate;
+        dodge.samples[i] = std::sin(phase) * std::sin(pi * progress);
+    }
+
+    // Peak at 1, the volumes in the settings are relative to that
+    for (Sound& sound : sounds)
+    {
+        float peak = 0.0f;
+        for (float sample : sound.samples) { peak = MyMathLib::max(peak, MyMathLib::abs(sample)); }
+        if (peak > 0.0f) { for (float& sample : sound.samples) { sample /= peak; } }
+    }
+}
+
+
+// * WAV files //
+// 16 bit PCM, stereo
+static void writeLittleEndian(std::ofstream& file, std::uint32_t value, int byteCount)
+{
+    for (int i = 0; i < byteCount; i++) { file.put((char)((value >> (i * 8)) & 0xff)); }
+}
+
+bool AudioMixer::writeWav(const std::string& fileName, const std::int16_t* samples, std::size_t frameCount, int sampleRate)
+{
+    std::ofstream file{fileName, std::ios::binary};
+    if (!file) { return false; }
+
+    std::uint32_t dataBytes = (std::uint32_t)(frameCount * channelCount * sizeof(std::int16_t));
+    file.write("RIFF", 4);
+    writeLittleEndian(file, 36 + dataBytes, 4);
+    file.write("WAVEfmt ", 8);
+    writeLittleEndian(file, 16, 4);                                     // Format chunk size
+    writeLittleEndian(file, 1, 2);                                      // PCM
+    writeLittleEndian(file, channelCount, 2);
+    writeLittleEndian(file, sampleRate, 4);
+    writeLittleEndian(file, sampleRate * channelCount * 2, 4);          // Bytes per second
+    writeLittleEndian(file, channelCount * 2, 2);                       // Bytes per frame
+    writeLittleEndian(file, 16, 2);                                     // Bits per sample
+    file.write("data", 4);
+    writeLittleEndian(file, dataBytes, 4);
+    for (std::size_t i = 0; i < frameCount * channelCount; i++) { writeLittleEndian(file, (std::uint16_t)samples[i], 2); }
+
+    return (bool)file;
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "spscQueue.h"
+
+class World;
+
+struct AudioSettings
+{
+    int sampleRate = 44100;
+
+    // Hard cap on what gets mixed, the mixing cost only depends on these and not on the amount of cars
+    static constexpr int maxEngineVoices = 8;   // The player's engine and the nearest cars
+    static constexpr int maxOneShotVoices = 4;  // Crashes and dodges, a new one replaces the oldest
+
+    // Cars further away from the player than this are not heard
+    float cullDistance = 1400.0f;
+    // Cars closer than this play at full volume
+    float referenceDistance = 250.0f;
+
+    // Engine pitch at rest and at max velocity (1 = the recorded pitch)
+    float enginePitchMin = 0.6f;
+    float enginePitchMax = 2.2f;
+
+    float engineVolume = 0.25f;
+    float effectVolume = 0.8f;
+    float masterVolume = 0.7f;
+};
+
+// * Software mixer //
+// Engine sounds of the player and the nearest cars, plus crash and dodge sounds, mixed into 16 bit stereo
+// * update() runs on the game thread: picks the voices from the world and queues their parameters
+// * mix() runs on the audio thread (see AudioStream), or on any thread to render offline without a sound device
+// * The sounds are synthesized, so the game doesn't need any audio files
+class AudioMixer
+{
+    public:
+        static constexpr int channelCount = 2;
+
+        AudioMixer(const AudioSettings& settings = AudioSettings{});
+        AudioMixer(const AudioMixer& other) = delete;
+        AudioMixer& operator=(const AudioMixer& other) = delete;
+
+        const AudioSettings settings;
+
+        // Game thread, once per frame
+        void update(const World& world);
+
+        // Audio thread, fills frameCount interleaved stereo frames
+        void mix(std::int16_t* samples, std::size_t frameCount);
+
+        // The engine voices that were audible in the last update, and the commands dropped because the queue was full
+        int activeEngineVoices() const { return audibleEngines; }
+        int droppedCommands() const { return dropped.load(std::memory_order_relaxed); }
+
+        static bool writeWav(const std::string& fileName, const std::int16_t* samples, std::size_t frameCount, int sampleRate);
+
+    private:
+        enum class SoundId : std::uint8_t { ENGINE, CRASH, DODGE };
+
+        struct Sound
+        {
+            std::vector<float> samples;
+            bool looping;
+        };
+
+        // Parameters sent from the game thread to the audio thread
+        struct Command
+        {
+            enum class Type : std::uint8_t { ENGINE, ONE_SHOT } type;
+            SoundId sound;
+            std::uint8_t slot;  // Engine voice slot
+            float gain;
+            float pan;          // -1 left, 1 right
+            float pitch;
+        };
+
+        struct Voice
+        {
+            const Sound* sound = nullptr;
+            double position = 0.0;
+            float pitch = 1.0f;
+            float gain = 0.0f;          // Current gain, ramps towards targetGain so changes don't click
+            float targetGain = 0.0f;
+            float pan = 0.0f;
+        };
+
+        Sound sounds[3];
+
+        // * Game thread //
+        SpscQueue<Command, 256> commands;
+        std::atomic<int> dropped{0};
+        int engineIds[AudioSettings::maxEngineVoices];  // Body id per engine slot, -1 = free
+        int audibleEngines = 0;
+        std::uint64_t eventCursor = 0;  // The next world event to play (see WorldEvents)
+
+        // * Audio thread //
+        Voice engines[AudioSettings::maxEngineVoices];
+        Voice oneShots[AudioSettings::maxOneShotVoices];
+        int nextOneShot = 0;
+
+        void send(const Command& command);
+        void apply(const Command& command);
+        void mixVoice(Voice& voice, float* left, float* right, std::size_t frameCount);
+
+        void synthesize();
+};
\ No newline at end of file
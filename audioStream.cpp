@@ -0,0 +1,20 @@
+#include "audioStream.h"
+
+AudioStream::AudioStream(AudioMixer& mixer) : mixer(mixer)
+{
+    initialize(AudioMixer::channelCount, mixer.settings.sampleRate);
+}
+
+// The streaming thread has to be stopped before the buffer goes away
+AudioStream::~AudioStream() { stop(); }
+
+bool AudioStream::onGetData(Chunk& data)
+{
+    mixer.mix(samples, chunkFrames);
+    data.samples = samples;
+    data.sampleCount = chunkFrames * AudioMixer::channelCount;
+    return true;
+}
+
+// The mix is live, there is nothing to seek in
+void AudioStream::onSeek(sf::Time) {}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <SFML/Audio.hpp>
+
+#include "audioMixer.h"
+
+// Plays an AudioMixer on the sound device
+// * SFML requests the data on its own streaming thread, that is the thread the mixer mixes on
+class AudioStream : public sf::SoundStream
+{
+    public:
+        AudioStream(AudioMixer& mixer);
+        ~AudioStream();
+
+    private:
+        AudioMixer& mixer;
+
+        // About 12 ms at 44.1 kHz, SFML keeps a few of these queued
+        static constexpr std::size_t chunkFrames = 512;
+        std::int16_t samples[chunkFrames * AudioMixer::channelCount];
+
+        bool onGetData(Chunk& data) override;
+        void onSeek(sf::Time timeOffset) override;
+};
\ No newline at end of file
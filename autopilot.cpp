@@ -0,0 +1,115 @@
+#include "autopilot.h"
+
+// Every combination of horizontal (none, A, D) and vertical (none, W, S) input
+static const std::uint8_t inputs[] = {
+    0, ACTION_LEFT, ACTION_RIGHT,
+    ACTION_UP, ACTION_UP | ACTION_LEFT, ACTION_UP | ACTION_RIGHT,
+    ACTION_DOWN, ACTION_DOWN | ACTION_LEFT, ACTION_DOWN | ACTION_RIGHT };
+static constexpr int inputCount = sizeof(inputs) / sizeof(inputs[0]);
+static constexpr int candidateCount = inputCount * inputCount;
+
+Autopilot::Autopilot(const World& world, ThreadPool& threadPool, const AutopilotSettings& settings) :
+    settings(settings), threadPool(threadPool)
+{
+    // The rollouts don't draw, so the worlds don't need any textures, but they do collide like the game
+    BodyType playerType{world.playerType.width, world.playerType.height, TextureHandle{}, world.playerType.mask};
+    std::vector<BodyType> carTypes;
+    for (const BodyType& carType : world.carTypes) { carTypes.push_back({carType.width, carType.height, TextureHandle{}, carType.mask}); }
+
+    for (int i = 0; i < threadPool.threadCount(); i++)
+    {
+        freeWorlds.push_back(new World{world.settings, world.windowSize, playerType, carTypes});
+        // Restoring the game into a rollout world needs as many cars as the game has room for
+        freeWorlds.back()->reserveCars(world.carCapacity());
+    }
+
+    scheduler.start(planning());
+}
+
+Autopilot::~Autopilot()
+{
+    for (World* world : freeWorlds) { delete world; }
+}
+
+std::uint8_t Autopilot::update(const World& world, float deltaTime, FrameArena& frameArena)
+{
+    currentWorld = &world;
+    currentArena = &frameArena;
+    scheduler.advance(deltaTime);
+    return currentInput;
+}
+
+// Waits first, like a timer that starts at 0
+Behaviour Autopilot::planning()
+{
+    while (true)
+    {
+        co_await scheduler.wait(settings.decisionInterval);
+        currentInput = decide(*currentWorld, *currentArena);
+    }
+}
+
+std::uint8_t Autopilot::decide(const World& world, FrameArena& frameArena)
+{
+    WorldSnapshot* snapshot = frameArena.create<WorldSnapshot>();
+    if (!world.save(*snapshot)) { return currentInput; }
+    float* candidateScores = frameArena.allocateArray<float>(candidateCount);
+
+    int chunkSize = (candidateCount + threadPool.threadCount() - 1) / threadPool.threadCount();
+    threadPool.parallelFor(candidateCount, [&](int begin, int end)
+    {
+        World* rolloutWorld = acquireWorld();
+        for (int i = begin; i < end; i++)
+        {
+            candidateScores[i] = rollout(*rolloutWorld, *snapshot, inputs[i / inputCount], inputs[i % inputCount]);
+        }
+        releaseWorld(rolloutWorld);
+    }, chunkSize);
+
+    // Ties go to the first candidate, which is the one with no input
+    int best = 0;
+    for (int i = 1; i < candidateCount; i++)
+    {
+        if (candidateScores[i] > candidateScores[best]) { best = i; }
+    }
+
+    return inputs[best / inputCount];
+}
+
+World* Autopilot::acquireWorld()
+{
+    std::lock_guard<std::mutex> lock{freeWorldsMutex};
+    World* world = freeWorlds.back();
+    freeWorlds.pop_back();
+    return world;
+}
+
+void Autopilot::releaseWorld(World* world)
+{
+    std::lock_guard<std::mutex> lock{freeWorldsMutex};
+    freeWorlds.push_back(world);
+}
+
+// Simulates one candidate and returns the score it gained minus the penalty for getting hit
+float Autopilot::rollout(World& world, const WorldSnapshot& snapshot, std::uint8_t firstInput, std::uint8_t secondInput)
+{
+    world.restore(snapshot);
+
+    float startScore = world.score;
+    int health = world.bodies.player->health;
+    float penalty = 0.0f;
+
+    for (float time = 0.0f; time < settings.horizon && !world.gameOver; time += settings.stepTime)
+    {
+        std::uint8_t input = time < settings.switchTime ? firstInput : secondInput;
+        world.step(input & ACTION_LEFT, input & ACTION_RIGHT, input & ACTION_UP, input & ACTION_DOWN, settings.stepTime);
+
+        if (world.bodies.player->health < health)
+        {
+            penalty += settings.hitPenalty * (2.0f - time / settings.horizon);
+            health = world.bodies.player->health;
+        }
+    }
+
+    return world.score - startScore - penalty;
+}
\ No newline at end of file
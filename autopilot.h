@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "world.h"
+#include "frameArena.h"
+#include "threadPool.h"
+#include "scheduler.h"
+
+struct AutopilotSettings
+{
+    // How far ahead (in seconds) every candidate is simulated
+    float horizon = 1.5f;
+    // The deltaTime used within the rollouts, larger is cheaper but less precise
+    float stepTime = 1.0f / 20.0f;
+    // After how long the first input of a candidate switches to its second input
+    float switchTime = 0.3f;
+    // How often (in seconds) a new plan is made
+    float decisionInterval = 0.1f;
+    // Subtracted from the score of a candidate for every hit, earlier hits count up to twice
+    float hitPenalty = 1000.0f;
+};
+
+// Drives the player by simulating candidate inputs ahead of time and picking the best one
+// * Every candidate is a pair of inputs (A/W/D/S combinations), the first one held for switchTime and the second one after it
+// * Rollouts run on a headless copy of the world (snapshot), spread over the threads of the pool
+// * The snapshot and the candidate scores only live while planning, they are taken from the frame arena
+class Autopilot
+{
+    public:
+        Autopilot(const World& world, ThreadPool& threadPool, const AutopilotSettings& settings = AutopilotSettings{});
+        ~Autopilot();
+        Autopilot(const Autopilot& other) = delete;
+        Autopilot& operator=(const Autopilot& other) = delete;
+
+        AutopilotSettings settings;
+
+        // Returns the input to use this frame (ActionBit flags), plans again every decisionInterval
+        std::uint8_t update(const World& world, float deltaTime, FrameArena& frameArena);
+        // Plans from the current state of the world and returns the first input of the best candidate,
+        // a world too big for a snapshot keeps the last input
+        std::uint8_t decide(const World& world, FrameArena& frameArena);
+
+    private:
+        ThreadPool& threadPool;
+
+        std::vector<World*> freeWorlds;     // Headless worlds for the rollouts
+        std::mutex freeWorldsMutex;
+
+        std::uint8_t currentInput = 0;
+
+        // Plans every decisionInterval (see planning()), the world and the arena are the ones of the current update()
+        Scheduler scheduler;
+        const World* currentWorld = nullptr;
+        FrameArena* currentArena = nullptr;
+        Behaviour planning();
+
+        World* acquireWorld();
+        void releaseWorld(World* world);
+        float rollout(World& world, const WorldSnapshot& snapshot, std::uint8_t firstInput, std::uint8_t secondInput);
+};
\ No newline at end of file
@@ -0,0 +1,1121 @@
+// Headless benchmarks of the simulation and the rendering
+// * Run with the name of a benchmark to only run that one, no arguments runs all simulation benchmarks,
+//   an unknown name prints the usage and fails (exit code 1)
+// * render [frames] [timings.csv] [png folder] draws frames offscreen, it needs the textures and fonts folders and an OpenGL context
+// * allocations checks that headless frames don't allocate after warmup, it fails (exit code 1) when they do
+//   and needs a build with SPEEDRACER_TRACK_ALLOCATIONS, without it the check fails when asked for and is skipped
+//   (with a message) when running all benchmarks
+// * traffic compares dense traffic with and without the cars avoiding each other (see LaneIndex)
+// * timers compares polled timers with the timer wheel and with sleeping coroutines (see scheduler.h)
+// * checksums <log file> [frames] [seed] writes the checksum of every frame of a seeded run with scripted inputs,
+//   compare the logs of two builds with SpeedRacerChecksumDiff
+// * determinism plays the same kind of run and fails (exit code 1) when a fixed point build doesn't reproduce
+//   the recorded checksum, float builds only print theirs
+// * fixedPoint also times every integrator policy and brakes a body with each of them at steps up to 1/5 s,
+//   it fails (exit code 1) when one moves the body backwards, never stops it or drifts at the game's substeps
+// * pixelMask first checks the masks against a per pixel reference, it fails (exit code 1) on any mismatch
+// * particles keeps tens of thousands of particles alive and times their update and vertex building against a 1 ms budget
+// * audio [seconds] [out.wav] mixes the sound of a game offline, without a sound device, it first checks the mixed
+//   output and fails (exit code 1) when the level, the panning, the silence after a game over or the voice cap is off
+// * resolution feeds the resolution scaler frame times from a cost model and fails (exit code 1) when it doesn't
+//   settle within the budget, drop to its minimum under a load it can't hold or come back up when the load goes
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "vecEnv.h"
+#include "renderer.h"
+#include "integrators.h"
+#include "allocationTracker.h"
+#include "autopilot.h"
+#include "audioMixer.h"
+#include "checksumLog.h"
+#include "scheduler.h"
+#include "particleSystem.h"
+#include "resolutionScaler.h"
+// After myMathLib.h, some standard libraries define M_PI as a macro in <cmath>
+#include <cmath>
+
+using namespace std;
+
+double secondsSince(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+
+// * VecEnv throughput //
+void benchVecEnv()
+{
+    for (int envCount : {64, 1024})
+    {
+        VecEnv env{envCount};
+
+        vector<uint64_t> seeds(envCount);
+        for (int i = 0; i < envCount; i++) { seeds[i] = i; }
+
+        vector<float> observations(envCount * VecEnv::observationSize);
+        vector<float> rewards(envCount);
+        vector<uint8_t> done(envCount);
+        vector<uint8_t> actions(envCount);
+
+        env.reset(seeds.data(), observations.data());
+
+        Random random{1};
+        int steps = 0;
+        auto start = chrono::steady_clock::now();
+        while (secondsSince(start) < 2.0)
+        {
+            for (uint8_t& action : actions) { action = (uint8_t)random.range(16); }
+            env.step(actions.data(), observations.data(), rewards.data(), done.data());
+            steps++;
+        }
+        double seconds = secondsSince(start);
+
+        cout << "vecEnv  envs " << envCount << "  threads " << thread::hardware_concurrency()
+            << "  env steps/s " << (double)steps * envCount / seconds << endl;
+    }
+}
+
+
+// * Snapshot save / restore //
+void benchSnapshot()
+{
+
+    for (int carCount : {10, 1000})
+    {
+        WorldSettings settings;
+        settings.carsStartAmount = carCount;
+        settings.carsStartMaxAmount = carCount;
+
+        World world = headlessWorld(settings);
+        World other = headlessWorld(settings);
+        world.reset(1);
+        for (int i = 0; i < 10; i++) { world.step(false, false, true, false, 1.0f / 60.0f); }
+
+        WorldSnapshot* snapshot = new WorldSnapshot;
+        WorldSnapshot* copy = new WorldSnapshot;
+        const int iterations = carCount < 100 ? 200000 : 2000;
+
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) { world.save(*snapshot); }
+        double saveTime = secondsSince(start) / iterations;
+
+        start = chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) { snapshot->copyTo(*copy); }
+        double copyTime = secondsSince(start) / iterations;
+
+        start = chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) { world.restore(*copy); }
+        double restoreTime = secondsSince(start) / iterations;
+
+        // Restoring into a world with a different set of bodies
+        other.reset(2);
+        start = chrono::steady_clock::now();
+        other.restore(*copy);
+        double rebuildTime = secondsSince(start);
+
+        cout << "snapshot  cars " << carCount << "  bytes " << snapshot->usedSize()
+            << "  save " << saveTime * 1e9 << " ns  copy " << copyTime * 1e9 << " ns  restore " << restoreTime * 1e9
+            << " ns  restore (rebuild) " << rebuildTime * 1e9 << " ns" << endl;
+
+        delete snapshot;
+        delete copy;
+    }
+}
+
+
+// * Virtual vs static dispatch //
+void benchDispatch()
+{
+    const int carCount = 1000;
+    const int steps = 20;
+    const float deltaTime = 1.0f / 60.0f;
+
+    WorldSettings settings;
+    settings.carsStartAmount = carCount;
+    settings.carsStartMaxAmount = carCount;
+
+    World world = headlessWorld(settings);
+    world.reset(1);
+
+    WorldSnapshot* snapshot = new WorldSnapshot;
+    world.save(*snapshot);
+
+    // Same bodies behind base pointers, in the same order
+    list<RigidBody*> rbList;
+    rbList.push_back(world.bodies.player);
+    for (Car* car : world.bodies.cars) { rbList.push_back(car); }
+
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < steps; i++)
+    {
+        for (RigidBody* rbObject : rbList) { rbObject->update(rbList, world.windowSize, world.cameraPosition, deltaTime); }
+    }
+    double virtualTime = secondsSince(start) / steps;
+    Vector2 virtualPos = world.bodies.cars.back()->pos;
+
+    world.restore(*snapshot);
+
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < steps; i++)
+    {
+        world.bodies.player->update(world.bodies, world.windowSize, world.cameraPosition, deltaTime);
+        for (Car* car : world.bodies.cars) { car->update(world.bodies, world.windowSize, world.cameraPosition, deltaTime); }
+    }
+    double staticTime = secondsSince(start) / steps;
+
+    cout << "dispatch  cars " << carCount << "  virtual " << virtualTime * 1e3 << " ms/step  static "
+        << staticTime * 1e3 << " ms/step  speedup " << virtualTime / staticTime
+        << (virtualPos == world.bodies.cars.back()->pos ? "" : "  (results differ!)") << endl;
+
+    delete snapshot;
+}
+
+
+// * Fixed point vs float physics //
+// Steps free bodies through RigidBody::integrateMotion with the given integrator and scalar type,
+// positions are returned for comparing
+template <class Integrator, class T>
+double benchMotion(int bodyCount, int steps, vector<Vector2T<T>>& pos)
+{
+    const T deltaTime = T(1.0f / 60.0f);
+    const T maxVel = T(400.0f);
+    const T frictionCoefficient = T(1.0f);
+
+    Random random{1};
+    vector<Vector2T<T>> force(bodyCount);
+    for (Vector2T<T>& bodyForce : force) { bodyForce = Vector2T<T>{random.range(-400.0f, 400.0f), random.range(-750.0f, 0.0f)}; }
+    vector<Vector2T<T>> vel(bodyCount);
+    vector<Vector2T<T>> accel(bodyCount);
+    pos.assign(bodyCount, Vector2T<T>{});
+
+    auto start = chrono::steady_clock::now();
+    for (int step = 0; step < steps; step++)
+    {
+        for (int i = 0; i < bodyCount; i++)
+        {
+            // addForce with ForceMode::ACCELERATION
+            accel[i] = force[i] * deltaTime;
+            vel[i] += accel[i];
+
+            Vector2T<T> newVel;
+            Vector2T<T> newPos;
+            RigidBody::integrateMotion<Integrator, T>(pos[i], vel[i], accel[i], maxVel, frictionCoefficient, deltaTime, newVel, newPos);
+            vel[i] = newVel;
+            pos[i] = newPos;
+        }
+    }
+    return secondsSince(start);
+}
+
+// How far a body coasting at full speed goes until friction stops it, stepped with the given integrator
+// * steady is false when the body moved backwards on the way or didn't stop
+template <class Integrator>
+float brakingDistance(float deltaTime, bool& steady)
+{
+    Vector2T<float> pos{};
+    Vector2T<float> vel{0.0f, -400.0f};
+    // No force is added, friction builds up in the acceleration over the steps like it does in a game
+    Vector2T<float> accel{};
+    steady = true;
+    for (int step = 0; step < 100000 && vel.y != 0.0f; step++)
+    {
+        Vector2T<float> newVel;
+        Vector2T<float> newPos;
+        RigidBody::integrateMotion<Integrator, float>(pos, vel, accel, 400.0f, 1.0f, deltaTime, newVel, newPos);
+        if (newPos.y > pos.y || newPos.x != 0.0f) { steady = false; }
+        vel = newVel;
+        pos = newPos;
+    }
+    if (vel.y != 0.0f) { steady = false; }
+    return -pos.y;
+}
+
+// The braking distance of every integrator at steps from 1/240 s up to 1/5 s, against AnalyticFriction at 1/960 s
+// * Fails (returns false) when a policy moves a body backwards or never stops it, at any step,
+//   or drifts more than 1% at 1/240 s (the substeps of the game)
+// * How far each drifts at the larger steps is printed to compare them, nothing has to hold there
+bool checkIntegrators()
+{
+    bool steady;
+    const float reference = brakingDistance<AnalyticFriction>(1.0f / 960.0f, steady);
+
+    bool passed = steady;
+    for (float stepsPerSecond : {240.0f, 60.0f, 15.0f, 5.0f})
+    {
+        float deltaTime = 1.0f / stepsPerSecond;
+        bool steadies[3];
+        float errors[3] = {
+            abs(brakingDistance<ExplicitEuler>(deltaTime, steadies[0]) - reference) / reference,
+            abs(brakingDistance<SemiImplicitEuler>(deltaTime, steadies[1]) - reference) / reference,
+            abs(brakingDistance<AnalyticFriction>(deltaTime, steadies[2]) - reference) / reference};
+
+        bool ok = true;
+        for (int i = 0; i < 3; i++) { ok = ok && steadies[i] && (stepsPerSecond < 240.0f || errors[i] <= 0.01f); }
+        passed = passed && ok;
+
+        cout << "fixedPoint  braking at 1/" << stepsPerSecond << " s  error ExplicitEuler " << errors[0] * 100.0f
+            << "%  SemiImplicitEuler " << errors[1] * 100.0f << "%  AnalyticFriction " << errors[2] * 100.0f << "%"
+            << (ok ? "" : "  FAILED") << endl;
+    }
+    return passed;
+}
+
+bool benchFixedPoint()
+{
+    const int bodyCount = 1000;
+    const int steps = 600;
+
+    vector<Vector2T<float>> floatPos;
+    vector<Vector2T<Fixed>> fixedPos;
+    double floatTime = benchMotion<AnalyticFriction>(bodyCount, steps, floatPos);
+    double fixedTime = benchMotion<AnalyticFriction>(bodyCount, steps, fixedPos);
+
+    float maxDifference = 0.0f;
+    for (int i = 0; i < bodyCount; i++)
+    {
+        maxDifference = max(maxDifference, (floatPos[i] - Vector2T<float>{(float)fixedPos[i].x, (float)fixedPos[i].y}).magnitude());
+    }
+
+    cout << "fixedPoint  bodies " << bodyCount << "  float " << bodyCount * steps / floatTime / 1e6 << " M body steps/s  fixed "
+        << bodyCount * steps / fixedTime / 1e6 << " M body steps/s  fixed/float " << floatTime / fixedTime
+        << "  max position difference " << maxDifference << " px after " << steps << " steps"
+        << "  (simulation built with " << (sizeof(Scalar) == sizeof(Fixed) ? "fixed point)" : "float)") << endl;
+
+    // The same float bodies with the other policies, they only differ in how the position is taken
+    vector<Vector2T<float>> eulerPos;
+    double explicitTime = benchMotion<ExplicitEuler>(bodyCount, steps, eulerPos);
+    double semiImplicitTime = benchMotion<SemiImplicitEuler>(bodyCount, steps, eulerPos);
+    cout << "fixedPoint  integrators  ExplicitEuler " << bodyCount * steps / explicitTime / 1e6 << "  SemiImplicitEuler "
+        << bodyCount * steps / semiImplicitTime / 1e6 << "  AnalyticFriction " << bodyCount * steps / floatTime / 1e6
+        << " M body steps/s" << endl;
+
+    // The float step uses MyMathLib::sqrt like the game does, std::sqrt shows what a float step could cost instead
+    const int roots = 1000000;
+    vector<float> radicands(roots);
+    Random random{2};
+    for (float& radicand : radicands) { radicand = random.range(0.0f, 2000000.0f); }
+
+    double rootSums[3] = {};
+    double rootTimes[3] = {};
+    auto start = chrono::steady_clock::now();
+    for (float radicand : radicands) { rootSums[0] += std::sqrt(radicand); }
+    rootTimes[0] = secondsSince(start);
+    start = chrono::steady_clock::now();
+    for (float radicand : radicands) { rootSums[1] += MyMathLib::sqrt(radicand); }
+    rootTimes[1] = secondsSince(start);
+    start = chrono::steady_clock::now();
+    for (float radicand : radicands) { rootSums[2] += (float)Fixed::sqrt(Fixed{radicand}); }
+    rootTimes[2] = secondsSince(start);
+
+    cout << "fixedPoint  sqrt  std::sqrt " << rootTimes[0] / roots * 1e9 << " ns  MyMathLib::sqrt " << rootTimes[1] / roots * 1e9
+        << " ns  Fixed::sqrt " << rootTimes[2] / roots * 1e9 << " ns  (sums " << rootSums[0] << " " << rootSums[1] << " " << rootSums[2] << ")" << endl;
+
+    return checkIntegrators();
+}
+
+
+// * Pixel masks //
+// An ellipse filling an image of the given size, a stand-in for a car texture
+PixelMask ellipseMask(int width, int height)
+{
+    sf::Image image;
+    image.create(width, height, sf::Color::Transparent);
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            float dx = (x + 0.5f) / width * 2.0f - 1.0f;
+            float dy = (y + 0.5f) / height * 2.0f - 1.0f;
+            if (dx * dx + dy * dy <= 1.0f) { image.setPixel(x, y, sf::Color::White); }
+        }
+    }
+    return PixelMask{image};
+}
+
+// Random pixels at a random density, up to 199 pixels wide so rows span up to 4 words
+PixelMask noiseMask(Random& random)
+{
+    int width = random.range(199) + 1;
+    int height = random.range(199) + 1;
+    float density = random.range(0.0f, 0.02f);
+
+    sf::Image image;
+    image.create(width, height, sf::Color::Transparent);
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            if (random.range(0.0f, 1.0f) < density) { image.setPixel(x, y, sf::Color::White); }
+        }
+    }
+    return PixelMask{image};
+}
+
+// A single set pixel somewhere in a mask of up to 199x199, it only overlaps at exactly the right shift
+PixelMask dotMask(Random& random)
+{
+    int width = random.range(199) + 1;
+    int height = random.range(199) + 1;
+
+    sf::Image image;
+    image.create(width, height, sf::Color::Transparent);
+    image.setPixel(random.range(width), random.range(height), sf::Color::White);
+    return PixelMask{image};
+}
+
+// Pixel by pixel, what overlaps() has to answer
+bool overlapsReference(const PixelMask& mask, const PixelMask& other, int offsetX, int offsetY)
+{
+    for (int y = 0; y < mask.height; y++)
+    {
+        for (int x = 0; x < mask.width; x++)
+        {
+            if (mask.test(x, y) && other.test(x - offsetX, y - offsetY)) { return true; }
+        }
+    }
+    return false;
+}
+
+// Compares overlaps() with the per pixel reference for random masks and offsets, fails (returns false) on any mismatch
+// * Sparse noise makes rows with short spans and gaps, ellipses make rows that are full from edge to edge,
+//   a single pixel only hits when every shift and word boundary is right
+bool checkPixelMask()
+{
+    const int cases = 20000;
+    Random random{3};
+    int mismatches = 0;
+    int hits = 0;
+    for (int i = 0; i < cases; i++)
+    {
+        PixelMask mask = i % 2 == 0 ? noiseMask(random) : ellipseMask(random.range(199) + 1, random.range(199) + 1);
+        PixelMask other = i % 4 == 0 ? dotMask(random) : i % 3 != 0 ? noiseMask(random) : ellipseMask(random.range(199) + 1, random.range(199) + 1);
+
+        // From barely touching on one side to barely touching on the other, plus a few that miss
+        int offsetX = (int)random.range(-other.width - 2.0f, mask.width + 2.0f);
+        int offsetY = (int)random.range(-other.height - 2.0f, mask.height + 2.0f);
+
+        bool expected = overlapsReference(mask, other, offsetX, offsetY);
+        hits += expected;
+        if (mask.overlaps(other, offsetX, offsetY) == expected) { continue; }
+
+        if (mismatches++ < 5)
+        {
+            cout << "pixelMask  MISMATCH  " << mask.width << "x" << mask.height << " vs " << other.width << "x" << other.height
+                << " at " << offsetX << ", " << offsetY << "  reference " << expected << endl;
+        }
+    }
+
+    cout << "pixelMask  " << cases << " random cases against the per pixel reference  " << mismatches << " mismatches  ("
+        << hits * 100.0 / cases << "% hit)" << endl;
+    return mismatches == 0;
+}
+
+// Steps the same 1000 cars with box collisions and with pixel masks, and times a single car against car test
+// * The cars are spread over a long stretch of road, so they touch about as often as in a game
+bool benchPixelMask()
+{
+    if (!checkPixelMask()) { return false; }
+
+    const int carCount = 1000;
+    const int steps = 20;
+    const float deltaTime = 1.0f / 60.0f;
+
+    vector<PixelMask> masks;
+    for (const CarArchetype& archetype : carArchetypes) { masks.push_back(ellipseMask(archetype.width, archetype.height)); }
+    PixelMask playerMask = ellipseMask(44, 100);
+
+    WorldSettings settings;
+    settings.carsStartAmount = carCount;
+    settings.carsStartMaxAmount = carCount;
+    settings.verticalSpawnLocationMax = 100000.0f;
+
+    double stepTimes[2];
+    for (int useMasks = 0; useMasks < 2; useMasks++)
+    {
+        vector<BodyType> carTypes;
+        for (int i = 0; i < carArchetypeCount; i++)
+        {
+            carTypes.push_back({carArchetypes[i].width, carArchetypes[i].height, TextureHandle{}, useMasks ? &masks[i] : nullptr});
+        }
+
+        World world{settings, Vector2{750.0f, 1250.0f}, BodyType{44, 100, TextureHandle{}, useMasks ? &playerMask : nullptr}, carTypes};
+        world.reset(1);
+
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < steps; i++) { world.step(false, false, true, false, deltaTime); }
+        stepTimes[useMasks] = secondsSince(start) / steps;
+    }
+
+    // Overlapping by a random amount, like after a box hit
+    const int tests = 1000000;
+    Random random{1};
+    int hits = 0;
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < tests; i++) { hits += masks[0].overlaps(masks[1], random.range(-69, 70), random.range(-129, 130)); }
+    double testTime = secondsSince(start) / tests;
+
+    cout << "pixelMask  cars " << carCount << "  boxes " << stepTimes[0] * 1e3 << " ms/step  masks " << stepTimes[1] * 1e3
+        << " ms/step  car vs car test " << testTime * 1e9 << " ns (" << hits * 100.0 / tests << "% hit)" << endl;
+    return true;
+}
+
+
+// * Offscreen rendering //
+// Draws frames of a game with the real textures, the world is stepped outside of the timed part
+void benchRender(int frameCount, const string& timingsFile, const string& pngFolder)
+{
+    const float deltaTime = 1.0f / 60.0f;
+    Vector2 windowSize{750.0f, 1250.0f};
+
+    ResourceManager resources;
+    TextureHandle playerTexture = resources.load("motorcycle.png");
+    vector<BodyType> carTypes;
+    for (const CarArchetype& archetype : carArchetypes)
+    {
+        TextureHandle texture = resources.load(archetype.textureFile);
+        carTypes.push_back({texture.width(), texture.height(), texture, texture.mask()});
+    }
+
+    World world{WorldSettings{}, windowSize, BodyType{playerTexture.width(), playerTexture.height(), playerTexture, playerTexture.mask()}, carTypes};
+    world.reset(1);
+
+    OffscreenSurface surface{(unsigned)(int)windowSize.x, (unsigned)(int)windowSize.y};
+    Renderer renderer{resources, windowSize};
+    FrameArena frameArena;
+
+    vector<double> frameTimes(frameCount);
+    vector<int> drawCalls(frameCount);
+    for (int frame = 0; frame < frameCount; frame++)
+    {
+        if (world.gameOver) { world.reset(frame); }
+        world.step(false, false, true, false, deltaTime);
+
+        surface.resetDrawCalls();
+        auto start = chrono::steady_clock::now();
+        frameArena.reset();
+        renderer.draw(surface, world, frameArena);
+        surface.display();
+        frameTimes[frame] = secondsSince(start);
+        drawCalls[frame] = surface.drawCalls();
+
+        if (!pngFolder.empty())
+        {
+            char fileName[32];
+            snprintf(fileName, sizeof(fileName), "/frame%05d.png", frame);
+            surface.saveFrame(pngFolder + fileName);
+        }
+    }
+
+    if (!timingsFile.empty())
+    {
+        ofstream timings{timingsFile};
+        timings << "frame,drawCalls,renderMs" << endl;
+        for (int frame = 0; frame < frameCount; frame++) { timings << frame << "," << drawCalls[frame] << "," << frameTimes[frame] * 1e3 << endl; }
+    }
+
+    double totalTime = 0.0;
+    long totalDrawCalls = 0;
+    for (int frame = 0; frame < frameCount; frame++) { totalTime += frameTimes[frame]; totalDrawCalls += drawCalls[frame]; }
+    sort(frameTimes.begin(), frameTimes.end());
+
+    cout << "render  frames " << frameCount << "  draw calls/frame " << (double)totalDrawCalls / frameCount
+        << "  average " << totalTime / frameCount * 1e3 << " ms  median " << frameTimes[frameCount / 2] * 1e3
+        << " ms  p99 " << frameTimes[frameCount * 99 / 100] * 1e3 << " ms" << endl;
+}
+
+
+// * Dynamic resolution //
+// Frame times from a model instead of a GPU: a fixed part plus a part that follows the pixel count (scale squared)
+// * The load is the cost of the pixels at full scale, it changes between phases and the scaler has to follow
+// * The best scale for a load of 20 ms is 0.75 (3 + 20 * 0.75^2 = 14.25 ms), coming back from a heavier load may stop
+//   a step lower since raising is only guessed, 40 ms only fits at the min scale of 0.5
+bool checkResolutionScaler()
+{
+    const float budgetMs = 15.0f;
+    const float fixedMs = 3.0f;
+    const int phaseFrames = 400;
+    const int settleWithin = 120;
+
+    struct Phase { const char* name; float loadMs; float lowestScale; float highestScale; };
+    const Phase phases[] = {{"light", 10.0f, 1.0f, 1.0f}, {"heavy", 20.0f, 0.7f, 0.75f}, {"double", 40.0f, 0.5f, 0.5f},
+        {"heavy again", 20.0f, 0.7f, 0.75f}};
+
+    ResolutionScaler scaler{budgetMs};
+    bool passed = true;
+    for (const Phase& phase : phases)
+    {
+        int lastChange = -1;
+        float worstMs = 0.0f;
+        for (int frame = 0; frame < phaseFrames; frame++)
+        {
+            float scale = scaler.scale();
+            float frameMs = fixedMs + phase.loadMs * scale * scale;
+            int changes = scaler.changes();
+            scaler.frameFinished(frameMs);
+            if (scaler.changes() != changes) { lastChange = frame; }
+            if (frame >= settleWithin) { worstMs = max(worstMs, frameMs); }
+        }
+
+        // Settled within the first frames of the phase, within the budget after that, at the expected scale
+        float scale = scaler.scale();
+        bool ok = lastChange < settleWithin && worstMs <= budgetMs
+            && scale >= phase.lowestScale - 0.001f && scale <= phase.highestScale + 0.001f;
+        cout << "resolution  " << phase.name << " load  scale " << scale << "  last change at frame " << lastChange
+            << "  worst settled frame " << worstMs << " ms of " << budgetMs << "  " << (ok ? "ok" : "FAILED") << endl;
+        passed &= ok;
+    }
+
+    return passed;
+}
+
+
+// * Heap allocations per frame //
+// Runs headless frames (a game with the autopilot, and a VecEnv), counting allocations once everything is warmed up
+// * Games restart when they end, so resets and the car pool are part of the check
+bool benchAllocations()
+{
+    if (!AllocationTracker::enabled())
+    {
+        cout << "allocations  FAILED, allocations aren't tracked in this build, build with SPEEDRACER_TRACK_ALLOCATIONS" << endl;
+        return false;
+    }
+
+    const float deltaTime = 1.0f / 60.0f;
+    const int warmupFrames = 3000;
+    const int frames = 6000;
+
+    World world = headlessWorld();
+    world.reserveCars(world.settings.carsMaxAmountToWin());
+    world.reset(1);
+    ThreadPool threadPool;
+    Autopilot autopilot{world, threadPool};
+    ParticleSystem particles;
+    FrameArena frameArena;
+
+    const int envCount = 64;
+    VecEnv env{envCount};
+    vector<uint64_t> seeds(envCount);
+    for (int i = 0; i < envCount; i++) { seeds[i] = i; }
+    vector<float> observations(envCount * VecEnv::observationSize);
+    vector<float> rewards(envCount);
+    vector<uint8_t> done(envCount);
+    vector<uint8_t> actions(envCount);
+    env.reset(seeds.data(), observations.data());
+    Random random{1};
+
+    FrameAllocations gameAllocations;
+    FrameAllocations envAllocations;
+    for (int frame = 0; frame < warmupFrames + frames; frame++)
+    {
+        if (frame == warmupFrames) { gameAllocations = FrameAllocations{}; envAllocations = FrameAllocations{}; }
+
+        gameAllocations.frameStarted();
+        frameArena.reset();
+        if (world.gameOver) { world.reset(frame); }
+        uint8_t input = autopilot.update(world, deltaTime, frameArena);
+        world.step(input & ACTION_LEFT, input & ACTION_RIGHT, input & ACTION_UP, input & ACTION_DOWN, deltaTime);
+        particles.update(world, deltaTime);
+        particles.buildVertices(world.cameraPosition);
+        gameAllocations.frameEnded();
+
+        envAllocations.frameStarted();
+        for (uint8_t& action : actions) { action = (uint8_t)random.range(16); }
+        env.step(actions.data(), observations.data(), rewards.data(), done.data());
+        envAllocations.frameEnded();
+    }
+
+    bool passed = gameAllocations.maxAllocations() == 0 && envAllocations.maxAllocations() == 0;
+    cout << "allocations  frames " << frames << " after " << warmupFrames << " warmup  game max " << gameAllocations.maxAllocations()
+        << " (average " << gameAllocations.averageAllocations() << ")  vecEnv max " << envAllocations.maxAllocations()
+        << " (average " << envAllocations.averageAllocations() << ")  frame arena " << frameArena.highWater() / 1024 << " of "
+        << frameArena.capacity() / 1024 << " KiB  " << (passed ? "ok" : "FAILED") << endl;
+    return passed;
+}
+
+
+// * Traffic //
+// Dense traffic around a player that stands still, counting how often two cars start touching
+// * The touching pairs are found by brute force, outside of the timed part
+void benchTraffic()
+{
+    const int carCount = 150;
+    const int steps = 600;
+    const float deltaTime = 1.0f / 60.0f;
+
+    double stepTimes[2];
+    int collisions[2];
+    for (int avoid = 0; avoid < 2; avoid++)
+    {
+        WorldSettings settings;
+        settings.carsStartAmount = carCount;
+        settings.carsStartMaxAmount = carCount;
+        settings.verticalSpawnLocationMax = 15000.0f;
+        settings.carsAvoidTraffic = avoid;
+
+        World world = headlessWorld(settings);
+        world.reset(1);
+
+        stepTimes[avoid] = 0.0;
+        collisions[avoid] = 0;
+        vector<pair<int, int>> touching;
+        vector<pair<int, int>> lastTouching;
+        for (int i = 0; i < steps; i++)
+        {
+            auto start = chrono::steady_clock::now();
+            world.step(false, false, false, false, deltaTime);
+            stepTimes[avoid] += secondsSince(start);
+
+            touching.clear();
+            for (const Car* a : world.bodies.cars)
+            {
+                for (const Car* b : world.bodies.cars)
+                {
+                    if (a->id < b->id && abs((float)(a->pos.x - b->pos.x)) * 2.0f < a->width + b->width
+                        && abs((float)(a->pos.y - b->pos.y)) * 2.0f < a->height + b->height) { touching.push_back({a->id, b->id}); }
+                }
+            }
+            sort(touching.begin(), touching.end());
+
+            // Cars that spawned on top of each other don't count
+            if (i > 0)
+            {
+                for (const auto& pair : touching) { collisions[avoid] += !binary_search(lastTouching.begin(), lastTouching.end(), pair); }
+            }
+            swap(touching, lastTouching);
+        }
+    }
+
+    cout << "traffic  cars " << carCount << "  collisions " << collisions[0] << " -> " << collisions[1] << " avoiding  step "
+        << stepTimes[0] / steps * 1e3 << " -> " << stepTimes[1] / steps * 1e3 << " ms" << endl;
+}
+
+
+// * Timers //
+// Many entities that each do something every 1 to 60 seconds (mostly sleeping), for 10 simulated seconds at 60 fps
+// * Polled: a float accumulator per entity, checked every frame (how the game's timers worked before they moved to the wheel)
+// * Wheel: a timer per entity that schedules itself again when it fires
+// * Coroutines: a behaviour per entity that loops on co_await wait()
+int timerFires = 0;
+
+struct PeriodicTimer
+{
+    TimerWheel* wheel;
+    std::uint64_t period;
+
+    static void fire(void* context)
+    {
+        PeriodicTimer& timer = *static_cast<PeriodicTimer*>(context);
+        timerFires++;
+        timer.wheel->schedule(timer.period, &PeriodicTimer::fire, context);
+    }
+};
+
+Behaviour periodicBehaviour(Scheduler& scheduler, float period)
+{
+    while (true)
+    {
+        co_await scheduler.wait(period);
+        timerFires++;
+    }
+}
+
+void benchTimers()
+{
+    const float deltaTime = 1.0f / 60.0f;
+    const int frames = 600;
+    const float tickRate = 1000.0f;
+
+    for (int entityCount : {1000, 100000})
+    {
+        Random random{1};
+        vector<float> periods(entityCount);
+        for (float& period : periods) { period = random.range(1.0f, 60.0f); }
+
+        // Polled
+        timerFires = 0;
+        vector<float> timers(entityCount, 0.0f);
+        auto start = chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; frame++)
+        {
+            for (int i = 0; i < entityCount; i++)
+            {
+                timers[i] += deltaTime;
+                if (timers[i] >= periods[i]) { timers[i] -= periods[i]; timerFires++; }
+            }
+        }
+        double polledTime = secondsSince(start) / frames;
+        int polledFires = timerFires;
+
+        // Wheel
+        timerFires = 0;
+        TimerWheel wheel{entityCount};
+        vector<PeriodicTimer> periodicTimers(entityCount);
+        for (int i = 0; i < entityCount; i++)
+        {
+            periodicTimers[i] = {&wheel, (std::uint64_t)(periods[i] * tickRate + 0.5f)};
+            wheel.schedule(periodicTimers[i].period, &PeriodicTimer::fire, &periodicTimers[i]);
+        }
+        double pendingTicks = 0.0;
+        start = chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; frame++)
+        {
+            pendingTicks += deltaTime * tickRate;
+            std::uint64_t ticks = (std::uint64_t)pendingTicks;
+            pendingTicks -= (double)ticks;
+            wheel.advance(ticks);
+        }
+        double wheelTime = secondsSince(start) / frames;
+        int wheelFires = timerFires;
+
+        // Coroutines
+        timerFires = 0;
+        double coroutineTime;
+        {
+            Scheduler scheduler{tickRate};
+            for (float period : periods) { scheduler.start(periodicBehaviour(scheduler, period)); }
+            start = chrono::steady_clock::now();
+            for (int frame = 0; frame < frames; frame++) { scheduler.advance(deltaTime); }
+            coroutineTime = secondsSince(start) / frames;
+        }
+        int coroutineFires = timerFires;
+
+        cout << "timers  entities " << entityCount << "  polled " << polledTime * 1e6 << " us/frame (" << polledFires << " fires)  wheel "
+            << wheelTime * 1e6 << " us/frame (" << wheelFires << ")  coroutines " << coroutineTime * 1e6 << " us/frame (" << coroutineFires << ")" << endl;
+    }
+}
+
+
+// * Particles //
+// Bursts every frame keep the pool at about the given amount of live particles
+// * Times the update (simulate) and filling the vertex array, the draw call itself needs a surface so it isn't timed
+void benchParticles()
+{
+    const float deltaTime = 1.0f / 60.0f;
+    const int warmupFrames = 120;
+    const int frames = 600;
+    const ParticleEmitter& emitter = ParticleSystem::crashSmoke;
+    const float averageLifetime = (emitter.lifetimeMin + emitter.lifetimeMax) * 0.5f;
+
+    for (int target : {10000, 50000})
+    {
+        ParticleSystem particles{65536};
+        int perFrame = (int)(target / (averageLifetime / deltaTime));
+        Vector2 camPos{};
+
+        double simulateTime = 0.0;
+        double vertexTime = 0.0;
+        long long liveParticles = 0;
+        FrameAllocations allocations;
+        for (int frame = 0; frame < warmupFrames + frames; frame++)
+        {
+            bool timed = frame >= warmupFrames;
+            if (timed) { allocations.frameStarted(); }
+
+            auto start = chrono::steady_clock::now();
+            particles.emit(emitter, sf::Vector2f{375.0f, 600.0f}, sf::Vector2f{0.0f, 300.0f}, perFrame);
+            particles.simulate(deltaTime);
+            double simulated = secondsSince(start);
+
+            start = chrono::steady_clock::now();
+            int vertexCount = particles.buildVertices(camPos);
+            double built = secondsSince(start);
+
+            if (timed)
+            {
+                allocations.frameEnded();
+                simulateTime += simulated;
+                vertexTime += built;
+                liveParticles += vertexCount / 4;
+            }
+        }
+
+        double frameTime = (simulateTime + vertexTime) / frames;
+        cout << "particles  live " << liveParticles / frames << "  update " << simulateTime / frames * 1e6 << " us/frame  vertices "
+            << vertexTime / frames * 1e6 << " us/frame  " << (frameTime < 0.001 ? "within" : "OVER") << " the 1 ms budget  allocations "
+            << allocations.maxAllocations() << "  dropped " << particles.droppedParticles() << endl;
+    }
+}
+
+
+// * Checksum log //
+// The same seed always gives the same inputs and the same fixed steps, so two builds can be compared frame by frame
+// * The inputs change every 20 frames and a game that ends is restarted, so long runs keep covering new situations
+template <class F>
+void playScriptedRun(int frameCount, uint64_t seed, F&& onFrame)
+{
+    const float deltaTime = 1.0f / 60.0f;
+
+    World world = headlessWorld();
+    world.reset(seed);
+    Random inputRandom{seed + 1};
+    uint8_t input = 0;
+
+    for (int frame = 0; frame < frameCount; frame++)
+    {
+        if (world.gameOver) { world.reset(seed + frame); }
+        if (frame % 20 == 0) { input = (uint8_t)inputRandom.range(16); }
+
+        world.step(input & ACTION_LEFT, input & ACTION_RIGHT, input & ACTION_UP, input & ACTION_DOWN, deltaTime);
+        onFrame(frame, world);
+    }
+}
+
+bool recordChecksums(const string& fileName, int frameCount, uint64_t seed)
+{
+    ChecksumLog log{fileName};
+    if (!log.isOpen()) { cout << "Could not write " << fileName << endl; return false; }
+
+    auto start = chrono::steady_clock::now();
+    int unrecorded = 0;
+    playScriptedRun(frameCount, seed, [&](int frame, const World& world) { if (!log.record(frame, world)) { unrecorded++; } });
+
+    cout << "checksums  frames " << frameCount << "  seed " << seed << "  last " << hex << log.checksum() << dec
+        << "  " << secondsSince(start) / frameCount * 1e6 << " us/frame with logging" << endl;
+    if (unrecorded > 0) { cout << "checksums  FAILED, " << unrecorded << " frames had more bodies than a snapshot can hold" << endl; }
+    return unrecorded == 0;
+}
+
+
+// * Determinism //
+// The checksums of every frame of a scripted run, chained, so a difference in any frame shows even after a restart
+// ! The game rules decide this value, a change to them has to record the new one (from any fixed point build)
+const uint64_t fixedPointRunChecksum = 0xce0c817a4a018e85;
+const int determinismFrames = 3600;
+const uint64_t determinismSeed = 1;
+
+bool checkDeterminism()
+{
+    WorldSnapshot* snapshot = new WorldSnapshot;
+    uint64_t runChecksum = 0xcbf29ce484222325;
+    int unsavedFrame = -1;
+    playScriptedRun(determinismFrames, determinismSeed, [&](int frame, const World& world)
+    {
+        if (!world.save(*snapshot) && unsavedFrame < 0) { unsavedFrame = frame; }
+        runChecksum = (runChecksum ^ checksumOf(*snapshot)) * 0x100000001b3;
+    });
+    delete snapshot;
+    if (unsavedFrame >= 0)
+    {
+        cout << "determinism  FAILED, the world got too big for a snapshot at frame " << unsavedFrame << endl;
+        return false;
+    }
+
+    cout << "determinism  frames " << determinismFrames << "  seed " << determinismSeed << "  run checksum " << hex << runChecksum << dec;
+    if (sizeof(Scalar) != sizeof(Fixed))
+    {
+        cout << "  (float build, only fixed point builds are compared)" << endl;
+        return true;
+    }
+
+    bool passed = runChecksum == fixedPointRunChecksum;
+    if (passed) { cout << "  matches the recorded checksum" << endl; }
+    else { cout << "  FAILED, the recorded checksum is " << hex << fixedPointRunChecksum << dec << endl; }
+    return passed;
+}
+
+
+// * Audio mixing //
+// Mixes a lone player standing still, so the only voice is the player's engine at full gain in the middle,
+// then the traffic of the benchmark, checking what comes out
+bool checkAudioMix()
+{
+    const float deltaTime = 1.0f / 60.0f;
+    const int seconds = 2;
+    bool passed = true;
+
+    WorldSettings settings;
+    settings.carsStartAmount = 0;
+    settings.carsStartMaxAmount = 0;
+    World world = headlessWorld(settings);
+    world.reset(1);
+
+    AudioMixer mixer;
+    const int framesPerStep = mixer.settings.sampleRate / 60;
+    vector<int16_t> samples((size_t)framesPerStep * AudioMixer::channelCount);
+
+    // The first step ramps the engine up from silence, after that every peak of the engine loop (1) is at the full level
+    const float expectedPeak = mixer.settings.engineVolume * mixer.settings.masterVolume * std::cos(0.25f * 3.14159265f) * 32767.0f;
+    int peak = 0;
+    int channelDifference = 0;
+    for (int frame = 0; frame < seconds * 60; frame++)
+    {
+        world.step(false, false, false, false, deltaTime);
+        mixer.update(world);
+        mixer.mix(samples.data(), framesPerStep);
+        if (frame == 0) { continue; }
+
+        for (int i = 0; i < framesPerStep; i++)
+        {
+            peak = max(peak, abs((int)samples[i * 2]));
+            channelDifference = max(channelDifference, abs(samples[i * 2] - samples[i * 2 + 1]));
+        }
+    }
+    bool levelOk = abs(peak - expectedPeak) <= expectedPeak * 0.02f && channelDifference <= 1;
+    cout << "audio  lone engine peak " << peak << " (expected " << (int)expectedPeak << ")  largest left/right difference "
+        << channelDifference << "  " << (levelOk ? "ok" : "FAILED") << endl;
+    passed &= levelOk;
+
+    // The engines fade out within a step of the game ending
+    world.gameOver = true;
+    int gameOverPeak = 0;
+    for (int frame = 0; frame < 2; frame++)
+    {
+        mixer.update(world);
+        mixer.mix(samples.data(), framesPerStep);
+        if (frame == 0) { continue; }
+        for (int16_t sample : samples) { gameOverPeak = max(gameOverPeak, abs((int)sample)); }
+    }
+    cout << "audio  peak after the game ended " << gameOverPeak << "  " << (gameOverPeak == 0 ? "ok" : "FAILED") << endl;
+    passed &= gameOverPeak == 0;
+
+    // However many cars there are, only the voice cap is mixed and every command gets through
+    settings.carsStartAmount = 1000;
+    settings.carsStartMaxAmount = 1000;
+    settings.verticalSpawnLocationMax = 20000.0f;
+    World traffic = headlessWorld(settings);
+    traffic.reset(1);
+    AudioMixer trafficMixer;
+    int minEngines = AudioSettings::maxEngineVoices;
+    int maxEngines = 0;
+    double squareSum = 0.0;
+    for (int frame = 0; frame < seconds * 60; frame++)
+    {
+        if (traffic.gameOver) { traffic.reset(frame); }
+        traffic.step(false, false, true, false, deltaTime);
+        trafficMixer.update(traffic);
+        trafficMixer.mix(samples.data(), framesPerStep);
+
+        minEngines = min(minEngines, trafficMixer.activeEngineVoices());
+        maxEngines = max(maxEngines, trafficMixer.activeEngineVoices());
+        for (int16_t sample : samples) { squareSum += (double)sample * sample; }
+    }
+    double rms = sqrt(squareSum / ((double)seconds * 60 * samples.size()));
+    bool trafficOk = minEngines >= 1 && maxEngines <= AudioSettings::maxEngineVoices && rms > 100.0
+        && trafficMixer.droppedCommands() == 0;
+    cout << "audio  1000 cars  engines " << minEngines << " to " << maxEngines << " of " << AudioSettings::maxEngineVoices
+        << "  rms " << rms << "  dropped commands " << trafficMixer.droppedCommands() << "  " << (trafficOk ? "ok" : "FAILED") << endl;
+    passed &= trafficOk;
+
+    return passed;
+}
+
+// Mixes a game that drives straight up (so it crashes and dodges), once with the usual amount of cars
+// and once with a crowd, the mixing cost has to stay the same since the voices are capped
+bool benchAudio(float seconds, const string& wavFileName)
+{
+    if (!checkAudioMix()) { return false; }
+
+    const float deltaTime = 1.0f / 60.0f;
+    const int frames = (int)(seconds * 60.0f);
+
+    for (int carCount : {0, 1000})
+    {
+        WorldSettings settings;
+        if (carCount > 0)
+        {
+            settings.carsStartAmount = carCount;
+            settings.carsStartMaxAmount = carCount;
+            settings.verticalSpawnLocationMax = 20000.0f;
+        }
+
+        World world = headlessWorld(settings);
+        world.reset(1);
+
+        AudioMixer mixer;
+        const int framesPerStep = mixer.settings.sampleRate / 60;
+        vector<int16_t> samples((size_t)frames * framesPerStep * AudioMixer::channelCount);
+
+        double updateTime = 0.0;
+        double mixTime = 0.0;
+        int audibleEngines = 0;
+        for (int frame = 0; frame < frames; frame++)
+        {
+            if (world.gameOver) { world.reset(frame); }
+            world.step(false, false, true, false, deltaTime);
+
+            auto start = chrono::steady_clock::now();
+            mixer.update(world);
+            updateTime += secondsSince(start);
+
+            start = chrono::steady_clock::now();
+            mixer.mix(&samples[(size_t)frame * framesPerStep * AudioMixer::channelCount], framesPerStep);
+            mixTime += secondsSince(start);
+
+            audibleEngines += mixer.activeEngineVoices();
+        }
+
+        cout << "audio  cars " << (carCount > 0 ? carCount : settings.carsStartAmount) << "  update " << updateTime / frames * 1e6
+            << " us/frame  mix " << mixTime / seconds * 1e3 << " ms per second of audio  average engines "
+            << (float)audibleEngines / frames << " of " << AudioSettings::maxEngineVoices << endl;
+
+        if (carCount == 0 && !wavFileName.empty())
+        {
+            if (!AudioMixer::writeWav(wavFileName, samples.data(), samples.size() / AudioMixer::channelCount, mixer.settings.sampleRate))
+            {
+                cout << "Could not write " << wavFileName << endl;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+static const char* const benchmarkModes[] = {"vecEnv", "snapshot", "dispatch", "fixedPoint", "pixelMask", "traffic", "timers",
+    "particles", "audio", "allocations", "determinism", "resolution", "checksums", "render"};
+
+static void printUsage()
+{
+    cout << "Usage: SpeedRacerBench [mode [arguments]], the modes are";
+    for (const char* mode : benchmarkModes) { cout << " " << mode; }
+    cout << endl;
+}
+
+int main(int argc, char** argv)
+{
+    string only = argc > 1 ? argv[1] : "";
+    if (!only.empty() && find(begin(benchmarkModes), end(benchmarkModes), only) == end(benchmarkModes))
+    {
+        cout << "Unknown benchmark " << only << endl;
+        printUsage();
+        return 1;
+    }
+
+    if (only.empty() || only == "vecEnv") { benchVecEnv(); }
+    if (only.empty() || only == "snapshot") { benchSnapshot(); }
+    if (only.empty() || only == "dispatch") { benchDispatch(); }
+    if (only.empty() || only == "fixedPoint") { if (!benchFixedPoint()) { return 1; } }
+    if (only.empty() || only == "pixelMask") { if (!benchPixelMask()) { return 1; } }
+    if (only.empty() || only == "traffic") { benchTraffic(); }
+    if (only.empty() || only == "timers") { benchTimers(); }
+    if (only.empty() || only == "particles") { benchParticles(); }
+    if (only.empty() || only == "audio")
+    {
+        if (!benchAudio(only.empty() || argc <= 2 ? 10.0f : max(stof(argv[2]), 1.0f), argc > 3 ? argv[3] : "")) { return 1; }
+    }
+    if (only == "allocations" || (only.empty() && AllocationTracker::enabled())) { if (!benchAllocations()) { return 1; } }
+    else if (only.empty()) { cout << "allocations  SKIPPED, build with SPEEDRACER_TRACK_ALLOCATIONS to check them" << endl; }
+    if (only.empty() || only == "determinism") { if (!checkDeterminism()) { return 1; } }
+    if (only.empty() || only == "resolution") { if (!checkResolutionScaler()) { return 1; } }
+    if (only == "checksums")
+    {
+        if (argc < 3) { cout << "checksums needs a log file" << endl; return 1; }
+        if (!recordChecksums(argv[2], argc > 3 ? max(stoi(argv[3]), 1) : 3600, argc > 4 ? stoull(argv[4]) : 1)) { return 1; }
+    }
+    if (only == "render")
+    {
+        int frameCount = argc > 2 ? max(stoi(argv[2]), 1) : 600;
+        benchRender(frameCount, argc > 3 ? argv[3] : "", argc > 4 ? argv[4] : "");
+    }
+
+    return 0;
+}
\ No newline at end of file
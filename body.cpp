@@ -1,20 +1,11 @@
 #include "body.h"
 
 Body::Body(int width, int height) :
-    width(width), height(height)
-{
-    pos = new Vector2{0.0f, 0.0f};
-};
+    pos{0.0f, 0.0f}, width(width), height(height) {};
 
-Body::~Body() { delete pos; };
-Body::Body(const Body& other)
-{
-    pos = new Vector2{other.pos->x, other.pos->y};
-    width = other.width;
-    height = other.height;
-};
+Body::~Body() = default;
 
-void Body::setPosition(Vector2& newPos)
+void Body::setPosition(const Vector2& newPos)
 {
-    *pos = newPos;
+    pos = newPos;
 }
\ No newline at end of file
@@ -8,12 +8,11 @@ class Body
     public:
         Body(int width, int height);
         virtual ~Body();
-        Body(const Body& other);
 
-        Vector2* pos;
+        Vector2 pos;
         int width;
         int height;
 
         bool update(float deltaTime);
-        void setPosition(Vector2& newPos);
+        void setPosition(const Vector2& newPos);
 };
\ No newline at end of file
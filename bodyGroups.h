@@ -0,0 +1,24 @@
+#pragma once
+
+#include <vector>
+
+#include "player.h"
+#include "car.h"
+
+// The bodies of a world grouped by their concrete type
+// * Stepping a group calls the handlers of its type directly (see RigidBody::updateNextPos)
+// * A new kind of body gets its own group here and in forEach()
+struct BodyGroups
+{
+    Player* player = nullptr;
+    // Unordered, a removed car's place is taken by the last car (see World::removeDeadCars)
+    std::vector<Car*> cars;
+
+    // Calls f with every body as its concrete type, the player first
+    template <class F>
+    void forEach(F&& f)
+    {
+        if (player != nullptr) { f(*player); }
+        for (Car* car : cars) { f(*car); }
+    }
+};
\ No newline at end of file
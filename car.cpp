@@ -1,45 +1,108 @@
 #include "car.h"
+#include "bodyGroups.h"
+#include "laneIndex.h"
 
-Car::Car(int id, int width, int height, float maxVel, float forceAmountPerFrame, float frictionCoefficient,
-    float mass, float horizontalMultiplier, bool horizontalDir) :
-    RigidBody{id, width, height, maxVel, forceAmountPerFrame, frictionCoefficient, mass, Faction::CAR},
-    horizontalMultiplier(horizontalMultiplier), horizontalDir(horizontalDir) {};
+Car::Car(int id, int typeIndex, float forceAmountPerFrame, float horizontalMultiplier, bool horizontalDir) :
+    RigidBody{id, carArchetypes[typeIndex].width, carArchetypes[typeIndex].height, forceAmountPerFrame, Faction::CAR},
+    typeIndex(typeIndex), horizontalMultiplier(horizontalMultiplier), horizontalDir(horizontalDir) {};
 
 Car::~Car() = default;
 Car::Car(const Car& other) : RigidBody(other)
 {
+    typeIndex = other.typeIndex;
     alive = other.alive;
     horizontalMultiplier = other.horizontalMultiplier;
     horizontalDir = other.horizontalDir;
     lastHitID = other.lastHitID;
 };
 
+// Steers away from a car beside it, brakes behind a slower car close ahead and steers towards the neighbouring lane with more room
+void Car::avoidTraffic(const LaneIndex& lanes, float brakingDistance)
+{
+    braking = false;
+
+    // The room in a lane is the vertical gap to its closest car (up to brakingDistance), -1 off the road
+    auto roomIn = [&](int otherLane) -> Scalar
+    {
+        if (otherLane < 0 || otherLane >= lanes.laneCount()) { return Scalar{-1.0f}; }
+        const Car* other = lanes.nearest(otherLane, pos.y);
+        if (other == nullptr) { return Scalar{brakingDistance}; }
+        return MyMathLib::min(MyMathLib::abs(other->pos.y - pos.y) - (other->height + height) * 0.5f, Scalar{brakingDistance});
+    };
+    Scalar leftRoom = roomIn(lane - 1);
+    Scalar rightRoom = roomIn(lane + 1);
+
+    // * Beside //
+    // Drifting into a car in the next lane, turn around when the other side has more room
+    Scalar sideRoom = horizontalDir ? rightRoom : leftRoom;
+    Scalar otherSideRoom = horizontalDir ? leftRoom : rightRoom;
+    if (sideRoom < brakingDistance * 0.25f && otherSideRoom > sideRoom) { horizontalDir = !horizontalDir; }
+
+    // * Ahead //
+    const Car* front = lanes.ahead(*this);
+    if (front == nullptr) { return; }
+
+    // Far enough away, or pulling away
+    Scalar gap = front->pos.y - pos.y - (front->height + height) * 0.5f;
+    if (gap > brakingDistance || front->vel.y >= vel.y) { return; }
+    braking = true;
+
+    if (leftRoom > gap && leftRoom > rightRoom) { horizontalDir = false; }
+    else if (rightRoom > gap && rightRoom > leftRoom) { horizontalDir = true; }
+}
+
 void Car::movementLogic(float deltaTime)
 {
-    addForce(Vector2{forceAmountPerFrame * horizontalMultiplier * (int(horizontalDir)*2-1), forceAmountPerFrame}, ForceMode::ACCELERATION, deltaTime);
+    // Braking pushes back as hard as the car accelerates
+    Scalar verticalForce = braking ? -forceAmountPerFrame : forceAmountPerFrame;
+    addForce(Vector2{forceAmountPerFrame * horizontalMultiplier * (int(horizontalDir)*2-1), verticalForce}, ForceMode::ACCELERATION, deltaTime);
 }
 
-bool Car::update(std::list<RigidBody*>& rbList, Vector2& windowSize, sf::RenderWindow& window, Vector2& camPos, float deltaTime)
+bool Car::update(std::list<RigidBody*>& rbList, Vector2& windowSize, Vector2& camPos, float deltaTime)
 {
     movementLogic(deltaTime);
-    updateNextPos(rbList, windowSize, camPos, deltaTime);
+    BodyList bodies{rbList};
+    updateNextPos<RigidBody>(bodies, windowSize, camPos, deltaTime);
 
-    Vector2 screenSpace = *pos - camPos;
-    sprite->setPosition(screenSpace.x, screenSpace.y);
+    return alive;
+}
 
-    window.draw(*sprite);
+bool Car::update(BodyGroups& bodies, Vector2& windowSize, Vector2& camPos, float deltaTime)
+{
+    movementLogic(deltaTime);
+    updateNextPos<Car>(bodies, windowSize, camPos, deltaTime);
 
     return alive;
 }
 
+void Car::saveState(BodyState& state) const
+{
+    RigidBody::saveState(state);
+    state.typeIndex = typeIndex;
+    state.alive = alive;
+    state.horizontalDir = horizontalDir;
+    state.horizontalMultiplier = horizontalMultiplier;
+    state.lastHitID = lastHitID;
+}
+
+void Car::loadState(const BodyState& state)
+{
+    RigidBody::loadState(state);
+    typeIndex = state.typeIndex;
+    alive = state.alive;
+    horizontalDir = state.horizontalDir;
+    horizontalMultiplier = state.horizontalMultiplier;
+    lastHitID = state.lastHitID;
+}
+
 // When car is outside the screen on the bottom of the window, delete car
-void Car::onVerticalWindowHit(Vector2& currentVel, Vector2& nextPos, float windowPos, float camVerticalPos)
+void Car::onVerticalWindowHit(Vector2& currentVel, Vector2& nextPos, Scalar windowPos, Scalar camVerticalPos)
 {
     if (windowPos != 0.0f && nextPos.y - camVerticalPos - windowPos > height * 0.5f) { alive = false; }
 }
 
 // Bounce car when hitting left or right side of the window
-void Car::onHorizontalWindowHit(Vector2& currentVel, Vector2& nextPos, float windowPos, float camHorizontalPos)
+void Car::onHorizontalWindowHit(Vector2& currentVel, Vector2& nextPos, Scalar windowPos, Scalar camHorizontalPos)
 {
     if (windowPos <= 0.0f) // Hit left side of the game window
     {
@@ -60,14 +123,14 @@ bool Car::onObjectCollision(RigidBody& other)
     {
         lastHitID = other.id;
 
-        if (pos->x < other.pos->x)
+        if (pos.x < other.pos.x)
         {
-            vel->x = MyMathLib::abs(vel->x) * -1;
+            vel.x = MyMathLib::abs(vel.x) * -1;
             horizontalDir = false;
         }
         else
         {
-            vel->x = MyMathLib::abs(vel->x);
+            vel.x = MyMathLib::abs(vel.x);
             horizontalDir = true;
         }
         return true;
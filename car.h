@@ -1,27 +1,78 @@
 #pragma once
 
 #include "rigidBody.h"
+#include "carArchetypes.h"
 
-class Car : public RigidBody
+struct BodyGroups;
+class LaneIndex;
+
+class Car final : public RigidBody
 {
+    friend class RigidBody;
+    friend class LaneIndex;
+
     public:
-        Car(int id, int width, int height, float maxVel, float forceAmountPerFrame,
-            float frictionCoefficient, float mass, float horizontalMultiplier, bool horizontalDir);
+        // The hitbox and the physics constants come from the archetype
+        Car(int id, int typeIndex, float forceAmountPerFrame, float horizontalMultiplier, bool horizontalDir);
         virtual ~Car();
         Car(const Car& other);
 
-        bool alive = true;  // Whether the car is alive, is used as a return value in update()
-        
+        int typeIndex;      // Index of the car's archetype, also of its texture within the world
+
+        const CarArchetype& archetype() const { return carArchetypes[typeIndex]; }
+
+        using Integrator = AnalyticFriction;
+
+        void avoidTraffic(const LaneIndex& lanes, float brakingDistance);
         void movementLogic(float deltaTime);
-        bool update(std::list<RigidBody*>& rbList, Vector2& windowSize, sf::RenderWindow& window, Vector2& camPos, float deltaTime);
+        bool update(std::list<RigidBody*>& rbList, Vector2& windowSize, Vector2& camPos, float deltaTime);
+        bool update(BodyGroups& bodies, Vector2& windowSize, Vector2& camPos, float deltaTime);
+
+        void saveState(BodyState& state) const;
+        void loadState(const BodyState& state);
+
+        Scalar maxVelocity() const override;
+        Scalar friction() const override;
+        Scalar bodyMass() const override;
 
     private:
+        // Only what differs between cars, the bools last so they share the padding
         float horizontalMultiplier;
+        int lastHitID = -1;
+
+        // Where the car is in the lane index (see LaneIndex), -1 when it isn't in one
+        int lane = -1;
+        int laneSlot = -1;
+
+        bool alive = true;  // Whether the car is alive, is used as a return value in update()
         bool horizontalDir; // false = left, true = right
-        int lastHitID;
+        // Decided every step by avoidTraffic(), so it isn't part of the saved state
+        bool braking = false;
 
-        void onVerticalWindowHit(Vector2& currentVel, Vector2& nextPos, float windowPos, float camVerticalPos);
-        void onHorizontalWindowHit(Vector2& currentVel, Vector2& nextPos, float windowPos, float camHorizontalPos);
+        void onVerticalWindowHit(Vector2& currentVel, Vector2& nextPos, Scalar windowPos, Scalar camVerticalPos);
+        void onHorizontalWindowHit(Vector2& currentVel, Vector2& nextPos, Scalar windowPos, Scalar camHorizontalPos);
         
         bool onObjectCollision(RigidBody& other);
-};
\ No newline at end of file
+};
+
+// A value that every archetype shares is a constant, so stepping a car doesn't read the table for it
+inline Scalar Car::maxVelocity() const
+{
+    if constexpr (carArchetypesShare(&CarArchetype::maxVel)) { return Scalar(carArchetypes[0].maxVel); }
+    else { return Scalar(archetype().maxVel); }
+}
+
+inline Scalar Car::friction() const
+{
+    if constexpr (carArchetypesShare(&CarArchetype::frictionCoefficient)) { return Scalar(carArchetypes[0].frictionCoefficient); }
+    else { return Scalar(archetype().frictionCoefficient); }
+}
+
+inline Scalar Car::bodyMass() const
+{
+    if constexpr (carArchetypesShare(&CarArchetype::mass)) { return Scalar(carArchetypes[0].mass); }
+    else { return Scalar(archetype().mass); }
+}
+
+// Per car state only, sizeof(Car) was 128 (168 with SPEEDRACER_FIXED_POINT) when every car kept its own constants
+static_assert(sizeof(Car) <= sizeof(RigidBody) + 24, "Car should only add the state that differs between cars");
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+// * Car archetypes //
+// Everything that is the same for every car of a type, known at compile time
+// * A car only keeps its archetype index (Car::typeIndex), the rest of its state is what differs between cars
+// * A value that every archetype shares is a constant in the car code, the table isn't even read for it (see Car)
+// * The hitbox is the size of the texture, main.cpp warns when a texture doesn't match its archetype
+struct CarArchetype
+{
+    const char* textureFile;
+    int width;
+    int height;
+    float mass;
+    float frictionCoefficient;  // Between 0.0f and 1.0f
+    float maxVel;
+    int spawnWeight;            // Relative chance of a new car being of this type
+};
+
+inline constexpr CarArchetype carArchetypes[] =
+{
+    {"carBlack.png",  71, 131, 100.0f, 1.0f, 400.0f, 1},
+    {"carBlue.png",   70, 130, 100.0f, 1.0f, 400.0f, 1},
+    {"carGreen.png",  70, 121, 100.0f, 1.0f, 400.0f, 1},
+    {"carOrange.png", 70, 131, 100.0f, 1.0f, 400.0f, 1},
+    {"carYellow.png", 71, 116, 100.0f, 1.0f, 400.0f, 1},
+};
+
+inline constexpr int carArchetypeCount = (int)(sizeof(carArchetypes) / sizeof(carArchetypes[0]));
+
+// Whether every archetype has the same value for member
+template <class T>
+constexpr bool carArchetypesShare(T CarArchetype::* member)
+{
+    for (const CarArchetype& archetype : carArchetypes)
+    {
+        if (archetype.*member != carArchetypes[0].*member) { return false; }
+    }
+    return true;
+}
+
+constexpr int carSpawnWeightTotal()
+{
+    int total = 0;
+    for (const CarArchetype& archetype : carArchetypes) { total += archetype.spawnWeight; }
+    return total;
+}
+
+// The archetype for a roll between 0 and carSpawnWeightTotal() - 1
+// * With equal weights the roll is the index, so picking by weight gives the same cars as picking by index
+constexpr int carArchetypeForRoll(int roll)
+{
+    for (int i = 0; i < carArchetypeCount; i++)
+    {
+        roll -= carArchetypes[i].spawnWeight;
+        if (roll < 0) { return i; }
+    }
+    return carArchetypeCount - 1;
+}
+
+// The highest max velocity of any car, for scaling car velocities to -1..1
+constexpr float carMaxVelLimit()
+{
+    float limit = 0.0f;
+    for (const CarArchetype& archetype : carArchetypes) { limit = archetype.maxVel > limit ? archetype.maxVel : limit; }
+    return limit;
+}
+
+static_assert(carArchetypeCount > 0, "There has to be at least one car archetype");
+static_assert(carSpawnWeightTotal() > 0, "At least one car archetype has to be able to spawn");
\ No newline at end of file
@@ -0,0 +1,110 @@
+// Compares two checksum logs (see ChecksumLog) and reports the first frame and body where they differ
+// * Usage: SpeedRacerChecksumDiff <reference log> <other log>
+// * Exit code 0 when the logs match, 1 when they diverge, 2 when a log can't be read
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+struct BodyLine
+{
+    int id;
+    string checksum;
+    string x;
+    string y;
+};
+
+struct FrameBlock
+{
+    int frame = -1;
+    string checksum;
+    string score;
+    vector<BodyLine> bodies;
+};
+
+// Reads the next frame with its bodies, returns false at the end of the log
+bool readFrame(ifstream& file, string& pendingLine, FrameBlock& block)
+{
+    if (pendingLine.empty() && !getline(file, pendingLine)) { return false; }
+
+    int bodyCount = 0;
+    char tag;
+    istringstream{pendingLine} >> tag >> block.frame >> block.checksum >> block.score >> bodyCount;
+    pendingLine.clear();
+
+    block.bodies.clear();
+    string line;
+    while (getline(file, line))
+    {
+        if (line.empty()) { continue; }
+        if (line[0] == 'F') { pendingLine = line; break; }
+
+        BodyLine body;
+        istringstream{line} >> tag >> body.id >> body.checksum >> body.x >> body.y;
+        block.bodies.push_back(body);
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) { cout << "Usage: SpeedRacerChecksumDiff <reference log> <other log>" << endl; return 2; }
+
+    ifstream reference{argv[1]};
+    ifstream other{argv[2]};
+    if (!reference || !other) { cout << "Could not open " << (!reference ? argv[1] : argv[2]) << endl; return 2; }
+
+    string referencePending;
+    string otherPending;
+    FrameBlock a;
+    FrameBlock b;
+    int frames = 0;
+    while (true)
+    {
+        bool hasA = readFrame(reference, referencePending, a);
+        bool hasB = readFrame(other, otherPending, b);
+        if (!hasA && !hasB) { break; }
+        if (hasA != hasB)
+        {
+            cout << "Logs match for " << frames << " frames, then " << (hasA ? argv[2] : argv[1]) << " ends" << endl;
+            return 1;
+        }
+
+        if (a.frame != b.frame || a.checksum != b.checksum)
+        {
+            cout << "First divergence at frame " << a.frame << " (world " << a.checksum << " vs " << b.checksum
+                << ", score " << a.score << " vs " << b.score << ")" << endl;
+
+            for (size_t i = 0; i < a.bodies.size() || i < b.bodies.size(); i++)
+            {
+                if (i >= a.bodies.size() || i >= b.bodies.size())
+                {
+                    cout << "  body count " << a.bodies.size() << " vs " << b.bodies.size() << endl;
+                    return 1;
+                }
+
+                const BodyLine& bodyA = a.bodies[i];
+                const BodyLine& bodyB = b.bodies[i];
+                if (bodyA.id != bodyB.id || bodyA.checksum != bodyB.checksum)
+                {
+                    cout << "  first differing body: " << (i == 0 ? "player" : "car") << " id " << bodyA.id;
+                    if (bodyB.id != bodyA.id) { cout << " vs id " << bodyB.id; }
+                    cout << ", position (" << bodyA.x << ", " << bodyA.y << ") vs (" << bodyB.x << ", " << bodyB.y << ")" << endl;
+                    if (bodyA.x == bodyB.x && bodyA.y == bodyB.y) { cout << "  same position, so its velocity, acceleration or another field differs" << endl; }
+                    return 1;
+                }
+            }
+
+            cout << "  every body matches, the difference is in the world itself (score, timers or randomizer)" << endl;
+            return 1;
+        }
+        frames++;
+    }
+
+    cout << "Logs match (" << frames << " frames)" << endl;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#include "checksumLog.h"
+
+#include <cinttypes>
+#include <cstdio>
+
+// FNV-1a, cheap and spreads a change of a single bit over the whole value
+class Hasher
+{
+    public:
+        std::uint64_t value = 14695981039346656037ull;
+
+        void add(const void* data, std::size_t size)
+        {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i < size; i++) { value = (value ^ bytes[i]) * 1099511628211ull; }
+        }
+
+        // Field by field, the padding between them isn't part of the state
+        template <class T>
+        void add(const T& field) { add(&field, sizeof(T)); }
+        void add(const Vector2& vector) { add(vector.x); add(vector.y); }
+};
+
+std::uint64_t checksumOf(const BodyState& state)
+{
+    Hasher hasher;
+    hasher.add(state.id);
+    hasher.add(state.faction);
+    hasher.add(state.width);
+    hasher.add(state.height);
+    hasher.add(state.pos);
+    hasher.add(state.vel);
+    hasher.add(state.accel);
+    hasher.add(state.forceAmountPerFrame);
+    hasher.add(state.intangible);
+
+    if (state.faction == Faction::PLAYER)
+    {
+        hasher.add(state.health);
+        hasher.add(state.hit);
+        hasher.add(state.intangibleUntil);
+    }
+    else
+    {
+        hasher.add(state.typeIndex);
+        hasher.add(state.alive);
+        hasher.add(state.horizontalDir);
+        hasher.add(state.horizontalMultiplier);
+        hasher.add(state.lastHitID);
+    }
+    return hasher.value;
+}
+
+std::uint64_t checksumOf(const WorldSnapshot& snapshot)
+{
+    Hasher hasher;
+    hasher.add(snapshot.random.state);
+    hasher.add(snapshot.cameraPosition);
+    hasher.add(snapshot.score);
+    hasher.add(snapshot.carsDodged);
+    hasher.add(snapshot.gameOver);
+    hasher.add(snapshot.idCounter);
+    hasher.add(snapshot.carsMaxAmount);
+    hasher.add(snapshot.carsAmount);
+    hasher.add(snapshot.tick);
+    hasher.add(snapshot.pendingTicks);
+    hasher.add(snapshot.carsSpawnDeadline);
+    hasher.add(snapshot.bodyCount);
+    for (int i = 0; i < snapshot.bodyCount; i++) { hasher.add(checksumOf(snapshot.bodies[i])); }
+    return hasher.value;
+}
+
+
+// * Log //
+ChecksumLog::ChecksumLog(const std::string& fileName) : file(fileName), snapshot(new WorldSnapshot) {}
+
+ChecksumLog::~ChecksumLog() { delete snapshot; }
+
+bool ChecksumLog::record(int frame, const World& world)
+{
+    if (!world.save(*snapshot)) { return false; }
+    lastChecksum = checksumOf(*snapshot);
+
+    // Written with snprintf, an ostream would depend on its locale and precision settings
+    char line[128];
+    std::snprintf(line, sizeof(line), "F %d %016" PRIx64 " %.9g %d\n", frame, lastChecksum, snapshot->score, snapshot->bodyCount);
+    file << line;
+    for (int i = 0; i < snapshot->bodyCount; i++)
+    {
+        const BodyState& state = snapshot->bodies[i];
+        std::snprintf(line, sizeof(line), "B %d %016" PRIx64 " %.9g %.9g\n", state.id, checksumOf(state), (float)state.pos.x, (float)state.pos.y);
+        file << line;
+    }
+    return true;
+}
\ No newline at end of file
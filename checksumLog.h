@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "world.h"
+
+// * Checksums //
+// 64 bit FNV-1a over every field of the simulation state, floats (or Fixed) by their exact bits
+// * Any change in how a body moves shows up in the checksum of that frame, even when it is too small to see
+std::uint64_t checksumOf(const BodyState& state);
+std::uint64_t checksumOf(const WorldSnapshot& snapshot);  // Including the bodies
+
+// Writes the checksum of every frame of a run to a text file, compare two of them with SpeedRacerChecksumDiff
+// * A frame is a line "F <frame> <world checksum> <score> <body count>"
+//   followed by a line "B <id> <body checksum> <x> <y>" for every body, the player first
+// * Only runs with the same seed, inputs and deltaTimes can be compared, so use fixed steps (not the wall clock)
+class ChecksumLog
+{
+    public:
+        ChecksumLog(const std::string& fileName);
+        ~ChecksumLog();
+        ChecksumLog(const ChecksumLog& other) = delete;
+        ChecksumLog& operator=(const ChecksumLog& other) = delete;
+
+        bool isOpen() const { return file.is_open(); }
+
+        // Returns false and writes nothing when the world has more bodies than a snapshot can hold
+        bool record(int frame, const World& world);
+        // The world checksum of the last recorded frame
+        std::uint64_t checksum() const { return lastChecksum; }
+
+    private:
+        std::ofstream file;
+        WorldSnapshot* snapshot;
+        std::uint64_t lastChecksum = 0;
+};
\ No newline at end of file
@@ -0,0 +1,23 @@
+#include "collisionMatrix.h"
+
+CollisionMatrix::CollisionMatrix() : masks{}
+{
+    setReacts(Faction::CAR, Faction::CAR, true);
+    setReacts(Faction::PLAYER, Faction::CAR, true);
+}
+
+void CollisionMatrix::setReacts(Faction faction, Faction other, bool reacts)
+{
+    if (reacts) { masks[(int)faction] |= collisionLayerOf(other); }
+    else { masks[(int)faction] &= ~collisionLayerOf(other); }
+}
+
+bool CollisionMatrix::reacts(Faction faction, Faction other) const { return (masks[(int)faction] & collisionLayerOf(other)) != 0; }
+
+std::uint32_t CollisionMatrix::mask(Faction faction) const { return masks[(int)faction]; }
+
+void CollisionMatrix::apply(RigidBody& rbObject) const
+{
+    rbObject.collisionLayer = collisionLayerOf(rbObject.faction);
+    rbObject.collisionMask = mask(rbObject.faction);
+}
\ No newline at end of file
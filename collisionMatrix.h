@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include "rigidBody.h"
+
+// Which factions react to touching which other factions
+// * reacts(faction, other): a body of faction gets its onObjectCollision called when it touches a body of other
+// * A pair of bodies is only tested when at least one of them reacts to the other
+// * The defaults match the handlers: cars bounce off cars and the player gets hit by cars
+class CollisionMatrix
+{
+    public:
+        CollisionMatrix();
+
+        void setReacts(Faction faction, Faction other, bool reacts);
+        bool reacts(Faction faction, Faction other) const;
+
+        // Collision mask for bodies of the given faction
+        std::uint32_t mask(Faction faction) const;
+        void apply(RigidBody& rbObject) const;
+
+    private:
+        std::uint32_t masks[factionCount];
+};
\ No newline at end of file
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+// * Fixed point //
+// Signed number with 16 fractional bits, stored in 64 bits (Q47.16)
+// * Every operation is integer math, so results are bit-exact across compilers, flags and platforms
+// * 64 bits because positions keep growing with the distance driven, Q16.16 would overflow at 32768
+// * Mixing with a float or an int converts that value to Fixed first, so physics expressions stay in fixed point
+// * Anything else has to convert explicitly (Scalar{value}, (float)value), so float math can't slip into the simulation unnoticed
+// ! Converting from float truncates towards 0, a float that isn't a multiple of 1/65536 loses its last bits
+class Fixed
+{
+    public:
+        static constexpr int fractionBits = 16;
+        static constexpr std::int64_t one = std::int64_t{1} << fractionBits;
+
+        std::int64_t raw = 0;
+
+        constexpr Fixed() = default;
+        explicit constexpr Fixed(int value) : raw(std::int64_t{value} * one) {}
+        explicit constexpr Fixed(float value) : raw((std::int64_t)((double)value * one)) {}
+        explicit constexpr Fixed(double value) : raw((std::int64_t)(value * one)) {}
+
+        static constexpr Fixed fromRaw(std::int64_t raw) { Fixed result; result.raw = raw; return result; }
+
+        explicit constexpr operator float() const { return (float)((double)raw / one); }
+        // Truncated towards 0, like casting a float
+        explicit constexpr operator int() const { return (int)(raw / one); }
+
+        constexpr Fixed operator-() const { return fromRaw(-raw); }
+
+        constexpr Fixed& operator+=(Fixed other) { raw += other.raw; return *this; }
+        constexpr Fixed& operator-=(Fixed other) { raw -= other.raw; return *this; }
+        constexpr Fixed& operator*=(Fixed other) { raw = multiply(raw, other.raw); return *this; }
+        constexpr Fixed& operator/=(Fixed other) { raw = divide(raw, other.raw); return *this; }
+
+        friend constexpr Fixed operator+(Fixed a, Fixed b) { return fromRaw(a.raw + b.raw); }
+        friend constexpr Fixed operator-(Fixed a, Fixed b) { return fromRaw(a.raw - b.raw); }
+        friend constexpr Fixed operator*(Fixed a, Fixed b) { return fromRaw(multiply(a.raw, b.raw)); }
+        friend constexpr Fixed operator/(Fixed a, Fixed b) { return fromRaw(divide(a.raw, b.raw)); }
+
+        friend constexpr bool operator==(Fixed a, Fixed b) { return a.raw == b.raw; }
+        friend constexpr bool operator!=(Fixed a, Fixed b) { return a.raw != b.raw; }
+        friend constexpr bool operator<(Fixed a, Fixed b) { return a.raw < b.raw; }
+        friend constexpr bool operator<=(Fixed a, Fixed b) { return a.raw <= b.raw; }
+        friend constexpr bool operator>(Fixed a, Fixed b) { return a.raw > b.raw; }
+        friend constexpr bool operator>=(Fixed a, Fixed b) { return a.raw >= b.raw; }
+
+        // Square root rounded down, without any floating point math
+        static constexpr Fixed sqrt(Fixed value)
+        {
+            if (value.raw <= 0) { return Fixed{}; }
+            // sqrt(raw / one) * one = sqrt(raw * one), keep the shifted radicant within 64 bits
+            if (value.raw < (std::int64_t{1} << 46)) { return fromRaw((std::int64_t)squareRoot((std::uint64_t)value.raw << fractionBits)); }
+            return fromRaw((std::int64_t)squareRoot((std::uint64_t)value.raw) << (fractionBits / 2));
+        }
+
+    private:
+        // a * b / one rounded down, exact for any operands whose result fits in 64 bits
+        // * The 128 bit product is built from 32 bit halves, no compiler specific 128 bit type or intrinsic needed
+        static constexpr std::int64_t multiply(std::int64_t a, std::int64_t b)
+        {
+            bool negative = (a < 0) != (b < 0);
+            std::uint64_t magnitudeA = a < 0 ? 0 - (std::uint64_t)a : (std::uint64_t)a;
+            std::uint64_t magnitudeB = b < 0 ? 0 - (std::uint64_t)b : (std::uint64_t)b;
+
+            std::uint64_t lowA = magnitudeA & 0xffffffff, highA = magnitudeA >> 32;
+            std::uint64_t lowB = magnitudeB & 0xffffffff, highB = magnitudeB >> 32;
+            std::uint64_t lowLow = lowA * lowB;
+            std::uint64_t lowHigh = lowA * highB;
+            std::uint64_t highLow = highA * lowB;
+            std::uint64_t middle = (lowLow >> 32) + (lowHigh & 0xffffffff) + (highLow & 0xffffffff);
+            std::uint64_t productLow = (middle << 32) | (lowLow & 0xffffffff);
+            std::uint64_t productHigh = highA * highB + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+
+            // Rounding a negative result down rounds its magnitude up
+            if (negative)
+            {
+                std::uint64_t sum = productLow + (one - 1);
+                productHigh += sum < productLow ? 1 : 0;
+                productLow = sum;
+            }
+
+            std::uint64_t magnitude = (productLow >> fractionBits) | (productHigh << (64 - fractionBits));
+            return negative ? (std::int64_t)(0 - magnitude) : (std::int64_t)magnitude;
+        }
+
+        // a * one / b, truncated towards 0, exact for any operands whose result fits in 64 bits
+        // * The fraction bits of the quotient come from long division, so the remainder is never shifted past 64 bits
+        static constexpr std::int64_t divide(std::int64_t a, std::int64_t b)
+        {
+            bool negative = (a < 0) != (b < 0);
+            std::uint64_t magnitudeA = a < 0 ? 0 - (std::uint64_t)a : (std::uint64_t)a;
+            std::uint64_t magnitudeB = b < 0 ? 0 - (std::uint64_t)b : (std::uint64_t)b;
+
+            std::uint64_t quotient = magnitudeA / magnitudeB;
+            std::uint64_t remainder = magnitudeA % magnitudeB;
+            for (int i = 0; i < fractionBits; i++)
+            {
+                // remainder < magnitudeB <= 2^63, so doubling it can't overflow
+                remainder <<= 1;
+                quotient <<= 1;
+                if (remainder >= magnitudeB)
+                {
+                    remainder -= magnitudeB;
+                    quotient |= 1;
+                }
+            }
+            return negative ? (std::int64_t)(0 - quotient) : (std::int64_t)quotient;
+        }
+
+        // Integer square root, one result bit per iteration
+        static constexpr std::uint64_t squareRoot(std::uint64_t value)
+        {
+            std::uint64_t result = 0;
+            std::uint64_t bit = std::uint64_t{1} << 62;
+            while (bit > value) { bit >>= 2; }
+            while (bit != 0)
+            {
+                if (value >= result + bit)
+                {
+                    value -= result + bit;
+                    result = (result >> 1) + bit;
+                }
+                else { result >>= 1; }
+                bit >>= 2;
+            }
+            return result;
+        }
+};
+
+// * Mixed arithmetic //
+// Exact matches for Fixed with a built-in number, without them every mixed expression would be ambiguous
+template <class T>
+using IfArithmetic = typename std::enable_if<std::is_arithmetic<T>::value, int>::type;
+
+template <class T, IfArithmetic<T> = 0> constexpr Fixed operator+(Fixed a, T b) { return a + Fixed{b}; }
+template <class T, IfArithmetic<T> = 0> constexpr Fixed operator-(Fixed a, T b) { return a - Fixed{b}; }
+template <class T, IfArithmetic<T> = 0> constexpr Fixed operator*(Fixed a, T b) { return a * Fixed{b}; }
+template <class T, IfArithmetic<T> = 0> constexpr Fixed operator/(Fixed a, T b) { return a / Fixed{b}; }
+template <class T, IfArithmetic<T> = 0> constexpr Fixed operator+(T a, Fixed b) { return Fixed{a} + b; }
+template <class T, IfArithmetic<T> = 0> constexpr Fixed operator-(T a, Fixed b) { return Fixed{a} - b; }
+template <class T, IfArithmetic<T> = 0> constexpr Fixed operator*(T a, Fixed b) { return Fixed{a} * b; }
+template <class T, IfArithmetic<T> = 0> constexpr Fixed operator/(T a, Fixed b) { return Fixed{a} / b; }
+
+template <class T, IfArithmetic<T> = 0> constexpr bool operator==(Fixed a, T b) { return a == Fixed{b}; }
+template <class T, IfArithmetic<T> = 0> constexpr bool operator!=(Fixed a, T b) { return a != Fixed{b}; }
+template <class T, IfArithmetic<T> = 0> constexpr bool operator<(Fixed a, T b) { return a < Fixed{b}; }
+template <class T, IfArithmetic<T> = 0> constexpr bool operator<=(Fixed a, T b) { return a <= Fixed{b}; }
+template <class T, IfArithmetic<T> = 0> constexpr bool operator>(Fixed a, T b) { return a > Fixed{b}; }
+template <class T, IfArithmetic<T> = 0> constexpr bool operator>=(Fixed a, T b) { return a >= Fixed{b}; }
+template <class T, IfArithmetic<T> = 0> constexpr bool operator==(T a, Fixed b) { return Fixed{a} == b; }
+template <class T, IfArithmetic<T> = 0> constexpr bool operator!=(T a, Fixed b) { return Fixed{a} != b; }
+template <class T, IfArithmetic<T> = 0> constexpr bool operator<(T a, Fixed b) { return Fixed{a} < b; }
+template <class T, IfArithmetic<T> = 0> constexpr bool operator<=(T a, Fixed b) { return Fixed{a} <= b; }
+template <class T, IfArithmetic<T> = 0> constexpr bool operator>(T a, Fixed b) { return Fixed{a} > b; }
+template <class T, IfArithmetic<T> = 0> constexpr bool operator>=(T a, Fixed b) { return Fixed{a} >= b; }
+
+// * Scalar //
+// The number type of the simulation, fixed point when built with SPEEDRACER_FIXED_POINT (deterministic mode)
+#ifdef SPEEDRACER_FIXED_POINT
+using Scalar = Fixed;
+#else
+using Scalar = float;
+#endif
\ No newline at end of file
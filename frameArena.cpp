@@ -0,0 +1,34 @@
+#include "frameArena.h"
+
+FrameArena::FrameArena(std::size_t capacity) : buffer(capacity) {}
+
+void* FrameArena::allocate(std::size_t size, std::size_t alignment)
+{
+    std::size_t start = (offset + alignment - 1) / alignment * alignment;
+    frameBytes += size + (start - offset);
+
+    if (start + size <= buffer.size())
+    {
+        offset = start + size;
+        return buffer.data() + start;
+    }
+
+    // Doesn't fit, this frame gets a separate block (new[] is aligned for any fundamental type)
+    overflow.emplace_back(new unsigned char[size]);
+    return overflow.back().get();
+}
+
+void FrameArena::reset()
+{
+    if (frameBytes > peakBytes) { peakBytes = frameBytes; }
+
+    // Grow to the biggest frame so far, with room to spare
+    if (!overflow.empty())
+    {
+        overflow.clear();
+        buffer.resize(peakBytes + peakBytes / 2);
+    }
+
+    offset = 0;
+    frameBytes = 0;
+}
\ No newline at end of file
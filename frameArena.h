@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// Linear allocator for data that only lives for one frame
+// * allocate() bumps an offset into one buffer, reset() at the start of every frame frees everything at once
+// * Destructors are never called, only use it for trivially destructible data
+// * A frame that needs more than the buffer falls back to the heap, and the next reset() grows the buffer to fit,
+//   so after warmup a frame doesn't touch the heap
+class FrameArena
+{
+    public:
+        FrameArena(std::size_t capacity = 64 * 1024);
+        FrameArena(const FrameArena& other) = delete;
+        FrameArena& operator=(const FrameArena& other) = delete;
+
+        // ! alignment can't be more than alignof(std::max_align_t)
+        void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+        template <class T>
+        T* allocateArray(std::size_t count) { return static_cast<T*>(allocate(count * sizeof(T), alignof(T))); }
+
+        // Default constructs a T in the arena
+        template <class T>
+        T* create()
+        {
+            static_assert(std::is_trivially_destructible<T>::value, "The arena never calls destructors");
+            return new (allocate(sizeof(T), alignof(T))) T;
+        }
+
+        void reset();
+
+        std::size_t capacity() const { return buffer.size(); }
+        std::size_t used() const { return frameBytes; }     // Including what went to the heap
+        std::size_t highWater() const { return peakBytes; }
+
+    private:
+        std::vector<unsigned char> buffer;
+        std::size_t offset = 0;
+        std::size_t frameBytes = 0;
+        std::size_t peakBytes = 0;
+        std::vector<std::unique_ptr<unsigned char[]>> overflow;
+};
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <SFML/System.hpp>
+
+#include "framePacer.h"
+
+FramePacer::FramePacer(float targetRate) { setTargetRate(targetRate); }
+
+void FramePacer::setTargetRate(float targetRate)
+{
+    rate = targetRate;
+    frameDuration = targetRate > 0.0f ? (std::int64_t)(1000000000.0 / targetRate) : 0;
+    nextFrameStart = now() + frameDuration;
+}
+
+float FramePacer::targetRate() const { return rate; }
+
+std::int64_t FramePacer::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void FramePacer::wait()
+{
+    if (frameDuration == 0) { return; }
+
+    // Sleep until spinMargin before the deadline
+    std::int64_t sleepUntil = nextFrameStart - spinMargin;
+    std::int64_t current = now();
+    if (current < sleepUntil)
+    {
+        // sf::sleep raises the timer resolution on Windows while sleeping
+        sf::sleep(sf::microseconds((sleepUntil - current) / 1000));
+
+        // Oversleeping eats into the margin, give it more room next time (or slowly take it back)
+        std::int64_t overshoot = now() - sleepUntil;
+        if (overshoot > spinMargin / 2) { spinMargin = spinMargin * 3 / 2; }
+        else { spinMargin -= spinMargin / 64; }
+        spinMargin = spinMargin < minSpinMargin ? minSpinMargin : spinMargin > maxSpinMargin ? maxSpinMargin : spinMargin;
+    }
+
+    // Spin for the rest
+    while ((current = now()) < nextFrameStart) { std::this_thread::yield(); }
+
+    std::int64_t error = current - nextFrameStart;
+    frames++;
+    errorSum += error;
+    if (error > errorMax) { errorMax = error; }
+    recentErrors[(frames - 1) % errorWindow] = error;
+
+    // After a long frame start over instead of rushing to catch up
+    nextFrameStart = error > frameDuration ? current + frameDuration : nextFrameStart + frameDuration;
+}
+
+void FramePacer::resume() { nextFrameStart = now() + frameDuration; }
+
+int FramePacer::frameCount() const { return frames; }
+float FramePacer::averageErrorMs() const { return frames > 0 ? (float)errorSum / frames / 1000000.0f : 0.0f; }
+float FramePacer::maxErrorMs() const { return (float)errorMax / 1000000.0f; }
+
+int FramePacer::recentFrameCount() const { return frames < errorWindow ? frames : errorWindow; }
+
+// Sorts a copy of the window, only meant for reports
+float FramePacer::recentErrorPercentileMs(float share) const
+{
+    int count = recentFrameCount();
+    if (count == 0) { return 0.0f; }
+
+    std::int64_t sorted[errorWindow];
+    std::copy(recentErrors, recentErrors + count, sorted);
+    std::int64_t* rank = sorted + (int)(share * (count - 1) + 0.5f);
+    std::nth_element(sorted, rank, sorted + count);
+    return (float)*rank / 1000000.0f;
+}
\ No newline at end of file
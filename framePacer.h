@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+
+// Holds a steady framerate: sleeps for most of the frame, then spins for the last part
+// * The spin part adapts to how much the OS oversleeps, so it stays short on systems with precise sleeps
+// * Target rate 0 means unlimited (for example when vsync does the pacing)
+class FramePacer
+{
+    public:
+        FramePacer(float targetRate = 60.0f);
+
+        void setTargetRate(float targetRate);
+        float targetRate() const;
+
+        // Call once per frame, returns when the next frame should start
+        void wait();
+        // Starts pacing again from now after the frames stopped for a while (paused), the gap doesn't count as an error
+        void resume();
+
+        // Pacing error: how late a frame started compared to when it should have
+        int frameCount() const;
+        float averageErrorMs() const;
+        float maxErrorMs() const;
+        // Over the last errorWindow frames: the error that the given share of them (0 to 1) stayed within
+        float recentErrorPercentileMs(float share) const;
+        int recentFrameCount() const;
+
+        static constexpr int errorWindow = 1024;
+
+    private:
+        float rate = 0.0f;
+        std::int64_t frameDuration = 0;     // In nanoseconds
+        std::int64_t nextFrameStart = 0;
+
+        // How long before the deadline sleeping stops, grows when sleeps overshoot
+        std::int64_t spinMargin = 500000;
+        static constexpr std::int64_t minSpinMargin = 200000;
+        static constexpr std::int64_t maxSpinMargin = 4000000;
+
+        int frames = 0;
+        std::int64_t errorSum = 0;
+        std::int64_t errorMax = 0;
+        // The errors of the last errorWindow frames, oldest overwritten first
+        std::int64_t recentErrors[errorWindow] = {};
+
+        static std::int64_t now();
+};
\ No newline at end of file
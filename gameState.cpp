@@ -0,0 +1,27 @@
+#include "gameState.h"
+
+void GameStateMachine::togglePause()
+{
+    if (current == GameState::PLAYING) { current = GameState::PAUSED; }
+    else if (current == GameState::PAUSED) { current = GameState::PLAYING; }
+}
+
+void GameStateMachine::pause()
+{
+    if (current == GameState::PLAYING) { current = GameState::PAUSED; }
+}
+
+void GameStateMachine::gameEnded()
+{
+    if (current == GameState::PLAYING) { current = GameState::GAME_OVER; }
+}
+
+void GameStateMachine::restart()
+{
+    if (current == GameState::PAUSED || current == GameState::GAME_OVER) { current = GameState::RESTARTING; }
+}
+
+void GameStateMachine::restarted()
+{
+    if (current == GameState::RESTARTING) { current = GameState::PLAYING; }
+}
\ No newline at end of file
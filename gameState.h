@@ -0,0 +1,25 @@
+#pragma once
+
+enum class GameState { PLAYING, PAUSED, GAME_OVER, RESTARTING };
+
+// * Game states //
+// PLAYING steps and draws the world every frame, the other states only draw when something changed
+// * PAUSED (Space, or the window losing focus) and GAME_OVER are idle: the main loop blocks on window events,
+//   the input sampler and the sound stop, so a game left on the game over screen uses no CPU
+// * RESTARTING resets the world in place, the textures, sounds and threads stay loaded, then goes back to PLAYING
+// * A transition that doesn't start from the current state is ignored
+class GameStateMachine
+{
+    public:
+        GameState state() const { return current; }
+        bool idle() const { return current == GameState::PAUSED || current == GameState::GAME_OVER; }
+
+        void togglePause();     // PLAYING <-> PAUSED
+        void pause();           // PLAYING -> PAUSED
+        void gameEnded();       // PLAYING -> GAME_OVER
+        void restart();         // PAUSED or GAME_OVER -> RESTARTING
+        void restarted();       // RESTARTING -> PLAYING
+
+    private:
+        GameState current = GameState::PLAYING;
+};
\ No newline at end of file
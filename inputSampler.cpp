@@ -0,0 +1,99 @@
+#include <chrono>
+#include <SFML/Window.hpp>
+
+#include "inputSampler.h"
+#include "world.h"
+
+// Keys and the action they hold
+static const sf::Keyboard::Key keys[] = {sf::Keyboard::A, sf::Keyboard::D, sf::Keyboard::W, sf::Keyboard::S};
+static const std::uint8_t keyActions[] = {ACTION_LEFT, ACTION_RIGHT, ACTION_UP, ACTION_DOWN};
+
+InputSampler::InputSampler()
+{
+    if (ownThread) { thread = std::thread{&InputSampler::sampleLoop, this}; }
+}
+
+InputSampler::~InputSampler()
+{
+    {
+        std::lock_guard<std::mutex> lock{wakeMutex};
+        running = false;
+    }
+    wakeCondition.notify_one();
+    if (thread.joinable()) { thread.join(); }
+}
+
+void InputSampler::setActive(bool active)
+{
+    {
+        std::lock_guard<std::mutex> lock{wakeMutex};
+        sampling = active;
+    }
+    wakeCondition.notify_one();
+}
+
+std::int64_t InputSampler::now()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void InputSampler::poll()
+{
+    if (!ownThread && sampling) { sampleKeys(); }
+}
+
+void InputSampler::sampleLoop()
+{
+    while (running)
+    {
+        if (!sampling)
+        {
+            std::unique_lock<std::mutex> lock{wakeMutex};
+            wakeCondition.wait(lock, [this] { return sampling || !running; });
+            continue;
+        }
+
+        sampleKeys();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void InputSampler::sampleKeys()
+{
+    bool hasFocus = focused;
+
+    for (int i = 0; i < 4; i++)
+    {
+        bool pressed = hasFocus && sf::Keyboard::isKeyPressed(keys[i]);
+        if (pressed == ((sampledHeld & keyActions[i]) != 0)) { continue; }
+
+        // If the queue is full, the change is picked up again by the next sample
+        if (queue.push(InputEvent{now(), keyActions[i], pressed}))
+        {
+            sampledHeld = pressed ? sampledHeld | keyActions[i] : sampledHeld & ~keyActions[i];
+        }
+    }
+}
+
+
+// * Latency //
+void LatencyCounter::eventApplied(std::int64_t timestamp)
+{
+    if (pendingCount < maxPending) { pending[pendingCount++] = timestamp; }
+}
+
+void LatencyCounter::frameDisplayed(std::int64_t displayTime)
+{
+    for (int i = 0; i < pendingCount; i++)
+    {
+        std::int64_t latency = displayTime - pending[i];
+        sum += latency;
+        if (latency > max) { max = latency; }
+        total++;
+    }
+    pendingCount = 0;
+}
+
+int LatencyCounter::count() const { return total; }
+float LatencyCounter::averageMs() const { return total > 0 ? (float)sum / total / 1000.0f : 0.0f; }
+float LatencyCounter::maxMs() const { return (float)max / 1000.0f; }
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "spscQueue.h"
+
+// A change of a held input, timestamp in microseconds (see InputSampler::now())
+struct InputEvent
+{
+    std::int64_t timestamp;
+    std::uint8_t action;    // ActionBit
+    bool pressed;
+};
+
+// Samples A/W/D/S on its own thread (about 1000 times per second) and queues every change with its timestamp
+// * The game applies the events at the simulation step they happened in, instead of at the start of the next frame
+// ! SFML doesn't read the keyboard off the main thread on every platform (macOS needs the main thread),
+//   there the sampler has no thread and the main loop samples once per frame through poll()
+class InputSampler
+{
+    public:
+#ifdef __APPLE__
+        static constexpr bool ownThread = false;
+#else
+        static constexpr bool ownThread = true;
+#endif
+
+        InputSampler();
+        ~InputSampler();
+        InputSampler(const InputSampler& other) = delete;
+        InputSampler& operator=(const InputSampler& other) = delete;
+
+        // Set by the main thread, keys are ignored (and released) while the window is not focused
+        std::atomic<bool> focused{true};
+
+        // An inactive sampler sleeps until it is activated again, instead of waking up every millisecond
+        void setActive(bool active);
+
+        // Samples the keys on the calling thread when the sampler has no thread of its own, does nothing otherwise
+        void poll();
+
+        static std::int64_t now();
+
+        // Applies the events up to the given time to held (ActionBit flags), calls onEvent for every event
+        template <class F>
+        std::uint8_t apply(std::int64_t until, std::uint8_t held, F&& onEvent);
+
+    private:
+        SpscQueue<InputEvent, 256> queue;
+        std::atomic<bool> running{true};
+        std::atomic<bool> sampling{true};
+        std::mutex wakeMutex;
+        std::condition_variable wakeCondition;
+        std::thread thread;
+        // The held keys as last sampled, only used by the sampling thread
+        std::uint8_t sampledHeld = 0;
+
+        void sampleLoop();
+        void sampleKeys();
+};
+
+template <class F>
+std::uint8_t InputSampler::apply(std::int64_t until, std::uint8_t held, F&& onEvent)
+{
+    const InputEvent* event;
+    while ((event = queue.front()) != nullptr && event->timestamp <= until)
+    {
+        held = event->pressed ? held | event->action : held & ~event->action;
+        onEvent(*event);
+        queue.pop();
+    }
+    return held;
+}
+
+// Time from an input event until the frame that shows it has been displayed
+class LatencyCounter
+{
+    public:
+        void eventApplied(std::int64_t timestamp);
+        void frameDisplayed(std::int64_t displayTime);
+
+        int count() const;
+        float averageMs() const;
+        float maxMs() const;
+
+    private:
+        static constexpr int maxPending = 32;
+        std::int64_t pending[maxPending];
+        int pendingCount = 0;
+
+        int total = 0;
+        std::int64_t sum = 0;
+        std::int64_t max = 0;
+};
\ No newline at end of file
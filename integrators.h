@@ -0,0 +1,41 @@
+#pragma once
+
+#include "vector2.h"
+
+// * Integrators //
+// Policies for how a body moves during a step, picked at compile time per body type (Self::Integrator)
+// * The velocity is the same for all of them (see RigidBody::integrate), they only differ in the position
+// * vel is the velocity at the start of the step, newVel at the end of it
+// * moveTime is how long each axis keeps moving within the step, at most the step's deltaTime, shorter when friction stops it
+// * T is the scalar type, float or Fixed
+
+// pos += v0 * dt, cheapest, overshoots when friction stops the body within the step
+struct ExplicitEuler
+{
+    template <class T>
+    static Vector2T<T> position(const Vector2T<T>& pos, const Vector2T<T>& vel, const Vector2T<T>&, const Vector2T<T>&, T deltaTime)
+    {
+        return pos + vel * deltaTime;
+    }
+};
+
+// pos += v1 * dt, reacts to input a step earlier than explicit Euler, undershoots when friction stops the body
+struct SemiImplicitEuler
+{
+    template <class T>
+    static Vector2T<T> position(const Vector2T<T>& pos, const Vector2T<T>&, const Vector2T<T>& newVel, const Vector2T<T>&, T deltaTime)
+    {
+        return pos + newVel * deltaTime;
+    }
+};
+
+// Exact for a constant force plus friction: the average velocity over the time the axis moves
+// * An axis that friction stops halfway through the step doesn't overshoot, so it stays stable at large steps
+struct AnalyticFriction
+{
+    template <class T>
+    static Vector2T<T> position(const Vector2T<T>& pos, const Vector2T<T>& vel, const Vector2T<T>& newVel, const Vector2T<T>& moveTime, T)
+    {
+        return {pos.x + (vel.x + newVel.x) / 2.0f * moveTime.x, pos.y + (vel.y + newVel.y) / 2.0f * moveTime.y};
+    }
+};
\ No newline at end of file
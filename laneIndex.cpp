@@ -0,0 +1,115 @@
+#include "laneIndex.h"
+
+#include <algorithm>
+
+#include "car.h"
+
+void LaneIndex::configure(int laneCount, float roadWidth)
+{
+    lanes.assign(MyMathLib::max(laneCount, 1), {});
+    laneWidth = roadWidth / lanes.size();
+}
+
+// Every car could end up in the same lane
+void LaneIndex::reserve(int carCount)
+{
+    for (std::vector<Car*>& lane : lanes) { lane.reserve(carCount); }
+}
+
+int LaneIndex::laneOf(Scalar x) const { return MyMathLib::clamp((int)((float)x / laneWidth), 0, laneCount() - 1); }
+
+// Back to front, ties are broken by id so the order is the same in every run
+bool LaneIndex::inOrder(const Car& a, const Car& b) { return a.pos.y < b.pos.y || (a.pos.y == b.pos.y && a.id < b.id); }
+
+void LaneIndex::renumber(int lane, int fromSlot)
+{
+    std::vector<Car*>& cars = lanes[lane];
+    for (int slot = fromSlot; slot < (int)cars.size(); slot++) { cars[slot]->laneSlot = slot; }
+}
+
+void LaneIndex::insert(Car& car)
+{
+    car.lane = laneOf(car.pos.x);
+    std::vector<Car*>& cars = lanes[car.lane];
+    auto it = std::upper_bound(cars.begin(), cars.end(), &car, [](const Car* a, const Car* b) { return inOrder(*a, *b); });
+    int slot = (int)(it - cars.begin());
+    cars.insert(it, &car);
+    renumber(car.lane, slot);
+}
+
+void LaneIndex::remove(Car& car)
+{
+    if (car.lane < 0) { return; }
+
+    std::vector<Car*>& cars = lanes[car.lane];
+    cars.erase(cars.begin() + car.laneSlot);
+    renumber(car.lane, car.laneSlot);
+    car.lane = -1;
+}
+
+void LaneIndex::moved(Car& car)
+{
+    if (car.lane != laneOf(car.pos.x)) { remove(car); insert(car); return; }
+
+    // Still in the same lane, swap with the neighbours it passed (usually none)
+    std::vector<Car*>& cars = lanes[car.lane];
+    int slot = car.laneSlot;
+    while (slot + 1 < (int)cars.size() && inOrder(*cars[slot + 1], car))
+    {
+        cars[slot] = cars[slot + 1];
+        cars[slot]->laneSlot = slot;
+        slot++;
+    }
+    while (slot > 0 && inOrder(car, *cars[slot - 1]))
+    {
+        cars[slot] = cars[slot - 1];
+        cars[slot]->laneSlot = slot;
+        slot--;
+    }
+    cars[slot] = &car;
+    car.laneSlot = slot;
+}
+
+void LaneIndex::clear()
+{
+    for (std::vector<Car*>& cars : lanes)
+    {
+        for (Car* car : cars) { car->lane = -1; }
+        cars.clear();
+    }
+}
+
+// Sorting every lane at once, cheaper than inserting the cars one by one
+void LaneIndex::rebuild(const std::vector<Car*>& cars)
+{
+    clear();
+    for (Car* car : cars)
+    {
+        car->lane = laneOf(car->pos.x);
+        lanes[car->lane].push_back(car);
+    }
+    for (int lane = 0; lane < laneCount(); lane++)
+    {
+        std::sort(lanes[lane].begin(), lanes[lane].end(), [](const Car* a, const Car* b) { return inOrder(*a, *b); });
+        renumber(lane, 0);
+    }
+}
+
+const Car* LaneIndex::ahead(const Car& car) const
+{
+    if (car.lane < 0) { return nullptr; }
+
+    const std::vector<Car*>& cars = lanes[car.lane];
+    return car.laneSlot + 1 < (int)cars.size() ? cars[car.laneSlot + 1] : nullptr;
+}
+
+const Car* LaneIndex::nearest(int lane, Scalar y) const
+{
+    if (lane < 0 || lane >= laneCount() || lanes[lane].empty()) { return nullptr; }
+
+    const std::vector<Car*>& cars = lanes[lane];
+    auto it = std::lower_bound(cars.begin(), cars.end(), y, [](const Car* car, Scalar y) { return car->pos.y < y; });
+    if (it == cars.end()) { return cars.back(); }
+    if (it == cars.begin()) { return *it; }
+    return (*it)->pos.y - y < y - (*(it - 1))->pos.y ? *it : *(it - 1);
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+
+#include "vector2.h"
+
+class Car;
+
+// * Lane occupancy //
+// The cars of every lane, sorted from back to front (by y, the direction they drive in)
+// * Kept up to date as the cars move: a car only moves within its lane's order when it passes another one,
+//   and only changes lane when it crosses a road marking, so a step costs about one check per car
+// ! insert() and remove() (spawns, despawns and lane changes) shift the cars behind the slot and renumber them,
+//   linear in the size of the lane, a lane has to stay sorted so the slot can't be filled by the last car
+// * The car ahead is the next one in the lane (constant time), beside is a binary search in the next lane
+// ! A car belongs to the lane of its center, a car straddling a road marking is only in one of them
+class LaneIndex
+{
+    public:
+        void configure(int laneCount, float roadWidth);
+        void reserve(int carCount);
+
+        int laneCount() const { return (int)lanes.size(); }
+        int laneOf(Scalar x) const;
+
+        void insert(Car& car);
+        void remove(Car& car);
+        void moved(Car& car);   // After the car's position changed
+        void clear();
+        void rebuild(const std::vector<Car*>& cars);
+
+        // The next car in the same lane, nullptr when the lane is clear
+        const Car* ahead(const Car& car) const;
+        // The car of the given lane that is vertically closest to y, nullptr when the lane is empty or off the road
+        const Car* nearest(int lane, Scalar y) const;
+
+    private:
+        float laneWidth = 1.0f;
+        std::vector<std::vector<Car*>> lanes;
+
+        static bool inOrder(const Car& a, const Car& b);
+        void renumber(int lane, int fromSlot);
+};
\ No newline at end of file
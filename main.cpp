@@ -3,409 +3,327 @@
 // Font: https://www.dafont.com/super-cartoon.font
 
 // * Move the player character using WASD
-
+// * Press P (or start with --autopilot) to let the autopilot drive
+// * Press Space to pause, R to restart when paused or after the game is over
+// * --fps <rate> sets the target framerate (0 = unlimited), --vsync lets vsync pace the frames instead
+// * --mute turns the sound off
+// * --native-resolution always draws at the window's resolution, by default the scene resolution drops when frames take too long
+//   (not with --vsync, display() waits for the vertical blank there, so every frame looks like it took the whole refresh)
+
+#include <cstdlib>
 #include <iostream>
-#include <list>
+#include <memory>
+#include <string>
 #include <SFML/Graphics.hpp>
 
 #include "myMathLib.h"
 #include "vector2.h"
-#include "rigidBody.h"
-#include "player.h"
-#include "car.h"
+#include "world.h"
+#include "autopilot.h"
+#include "inputSampler.h"
+#include "framePacer.h"
+#include "renderer.h"
+#include "resolutionScaler.h"
+#include "frameArena.h"
+#include "allocationTracker.h"
+#include "audioMixer.h"
+#include "audioStream.h"
+#include "particleSystem.h"
+#include "gameState.h"
 
 using namespace std;
 
 // The size of the game window, needs to be constructed in main
 Vector2 windowSize;
 
-// List of all rigidbodies within the game
-// * Pointer because parent class is abstract
-list<RigidBody*> rbList;
-
-// ID for identifying rigidBodies
-int idCounter = 0;
-
-// Values that get added to the player's score for specific conditions
-float scoreForTravel = 0.01f;
-float scoreForDodging = 10.0f;
-
-// The score the player needs to obtain to win the game
-float winCondition = 1000.0f;
-
-// The amount of distance it takes to increase the maximum car amount (Difficulty increase over time)
-float diffIncrDistance = 5000.0f;
-
-// The position of the camera, is used to convert world space to screen space
-Vector2 cameraPosition{};
-// The vertical offset of the camera from the player
-float cameraVerticalOffset = -1150.0f;
-
-
-// * Player Variables //
-// decrease the player's hurtbox size (hurtbox is normally the same size as the given texture)
-int hurtboxLeewayWidth = 8;
-int hurtboxLeewayHeight = 8;
-
-// Player speed
-float playerForceAmount = 750.0f;
-// The intensity of the friction the player receives
-float playerFrictionCoefficient = 1.0f;
-float playerMaxVel = 1500.0f;
-float playerMass = 100.0f;
-int maxHealth = 3;
-float maxIntangibleTime = 3.0f;
-
-
-// * Car Variables //
-// Static variables
-float carMaxVel = 400.0f;
-float carMass = 100.0f;
-// The intensity of the friction the car receives
-float carFrictionCoefficient = 1.0f;
-
-// Min and Max of Horizontal and Vertical Speed of a car
-float carForceAmountMin = 50.0f;
-float carForceAmountMax = 400.0f;
 
-// Min and Max of the horizontal multiplier (horizontalForce = forceAmount * horizontalMultiplier)
-float horizontalMultiplierMin = 0.0f;
-float horizontalMultiplierMax = 1.5f;
+// * Simulation //
+// The longest simulation step, a frame is split into steps so input is applied at the step it happened in
+float maxSubstepTime = 1.0f / 240.0f;
+// A longer frame (a debugger, a dragged window) only simulates this many steps, the rest of its time is skipped
+int maxSubsteps = 24;
 
-// Min and Max of the vertical spawn location of the cars
-// (0.0f is the top of the game window, higher numbers will have the car spawn higher above the game window)
-float verticalSpawnLocationMin = 0.0f;
-float verticalSpawnLocationMax = windowSize.y * 0.5f;
 
-// Maximum amount of cars that can exist
-int carsStartMaxAmount = 3;
-int carsMaxAmount = carsStartMaxAmount;
-// The amount of cars that spawn at the start of the game
-int carsStartAmount = 2;
-// The current count of cars;
-int carsAmount = 0;
-
-// The max amount of time it takes for a car to spawn whenever carsAmount < carsMaxAmount
-float carsMaxSpawnTime = 3.0f;
-// The actual time it takes for a car to spawn
-float carsDesiredSpawnTime = carsMaxSpawnTime;
-// The timer for spawning cars
-float carsSpawnTimer = 0.0f;
-
-
-// * Road Markings //
-float roadMarkingWidth = 5.0f;
-float roadMarkingHeight = 20.0f;
-float roadMarkingdistance = 40.0f;
-int roadMarkingLineAmount = 5;
-
-
-// * Float randomizer //
-float randf(float min, float max) { return ((float)rand() / RAND_MAX) * (max - min) + min; }
-
-// * loading textures //
-sf::Texture loadTexture(const string fileName)
+static void printUsage()
 {
-    sf::Texture texture = sf::Texture();
-    if (!texture.loadFromFile("textures/" + fileName)) { cout << "Could not load image" << endl; }
-    return texture;
+    cout << "Usage: SpeedRacer [--autopilot] [--fps <rate>] [--vsync] [--mute] [--native-resolution]" << endl;
 }
 
-// Loads a list of textures
-list<sf::Texture> loadTexture(const list<string> fileNameList)
-{
-    list<sf::Texture> textureList;
-    for (const string fileName : fileNameList) { textureList.push_back(loadTexture(fileName)); }
-    return textureList;
-}
-
-
-// * Rigidbody initializers //
-Player& playerInitializer(sf::Texture& playerTexture)
-{
-    Player* player = new Player{idCounter++, (int)playerTexture.getSize().x - hurtboxLeewayWidth, (int)playerTexture.getSize().y - hurtboxLeewayHeight,
-        playerMaxVel, playerForceAmount, playerFrictionCoefficient, playerMass, maxHealth, maxIntangibleTime};
-
-    player->loadSprite(playerTexture);
-    player->setPosition(Vector2{windowSize.x * 0.5f, 0.0f});
 
-    rbList.push_back(player);
-
-    return *player;
-}
-
-void carInitializer(list<sf::Texture>& carTextureList, float cameraVerticalPos)
-{
-    auto it = carTextureList.begin();
-    // Randomize car type / texture
-    advance(it, rand() % carTextureList.size());
-
-    // Get dimensions
-    int width = it->getSize().x;
-    int halfWidth = width / 2;
-    int height = it->getSize().y;
-
-    // Randomize variables
-    float forceAmountPerFrame = randf(carForceAmountMin, carForceAmountMax);
-    float horizontalMultiplier = randf(horizontalMultiplierMin, horizontalMultiplierMax);
-    float verticalSpawnLocation = randf(verticalSpawnLocationMin, verticalSpawnLocationMax);
-
-    // Initialize Car and push_back into rbList
-    rbList.push_back(new Car{idCounter++, width, height, carMaxVel, forceAmountPerFrame,
-        carFrictionCoefficient, carMass, horizontalMultiplier, bool(rand() % 2)});
-    rbList.back()->loadSprite(*it);
-    // Randomize spawn position
-    rbList.back()->setPosition(Vector2{((float)rand() / RAND_MAX) * (windowSize.x - width) + halfWidth, -height * 0.5f - verticalSpawnLocation + cameraVerticalPos});
-
-    carsAmount++;
-}
+// * main //
+int main(int argc, char** argv){
+    bool autopilotEnabled = false;
+    float targetFrameRate = 60.0f;
+    bool vsync = false;
+    bool muted = false;
+    bool dynamicResolution = true;
+    for (int i = 1; i < argc; i++)
+    {
+        if (string(argv[i]) == "--autopilot") { autopilotEnabled = true; }
+        else if (string(argv[i]) == "--vsync") { vsync = true; }
+        else if (string(argv[i]) == "--mute") { muted = true; }
+        else if (string(argv[i]) == "--native-resolution") { dynamicResolution = false; }
+        else if (string(argv[i]) == "--fps")
+        {
+            // A rate, 0 or more, with nothing after the number
+            const char* rate = i + 1 < argc ? argv[++i] : "";
+            char* end = nullptr;
+            targetFrameRate = strtof(rate, &end);
+            if (end == rate || *end != '\0' || !(targetFrameRate >= 0.0f && targetFrameRate <= 10000.0f))
+            {
+                cout << "--fps takes a framerate from 0 (unlimited) up to 10000, not '" << rate << "'" << endl;
+                printUsage();
+                return 1;
+            }
+        }
+        else
+        {
+            cout << "Unknown option " << argv[i] << endl;
+            printUsage();
+            return 1;
+        }
+    }
 
+    // With vsync the frame time includes the wait for the vertical blank, it can't tell how long drawing took
+    if (vsync) { dynamicResolution = false; }
 
-// * main //
-int main(int, char**){
     sf::RenderWindow window{sf::VideoMode(750, 1250), "Speed Racer"};
-    window.setFramerateLimit(60);
+    window.setVerticalSyncEnabled(vsync);
+    FramePacer framePacer{vsync ? 0.0f : targetFrameRate};
 
-    windowSize = {(float)window.getSize().x, (float)window.getSize().y};
-
-    // Get seed for randomizer
-    srand((unsigned int)time(nullptr));
+    windowSize = Vector2{(float)window.getSize().x, (float)window.getSize().y};
 
     cout << "Use A, W, or D to move left, up, or right" << endl;
     cout << "Use S to slow down" << endl;
+    cout << "Use P to turn the autopilot on or off" << endl;
+
+    // Owns every texture, so it has to outlive the world and the UI
+    ResourceManager resources;
 
     // * Initialize Player //
-    sf::Texture& playerTexture = loadTexture("motorcycle.png");
-    Player& player = playerInitializer(playerTexture);
+    TextureHandle playerTexture = resources.load("motorcycle.png");
+    BodyType playerType{playerTexture.width(), playerTexture.height(), playerTexture, playerTexture.mask()};
 
 
     // * Initialize Cars //
-    list<sf::Texture>& carTextureList = loadTexture
-        ({"carBlack.png", "carBlue.png", "carGreen.png",
-            "carOrange.png", "carYellow.png"});
-
-    // Spawn Cars
-    for (int i = 0; i < carsStartAmount; i++) { carInitializer(carTextureList, cameraVerticalOffset); }
-
-
-    // * Background Elements //
-    sf::Uint8 grayValue = (sf::Uint8)50.0f;
-    sf::Color gray{grayValue, grayValue, grayValue};
-
-    // White lines in the background
-    sf::RectangleShape rectRoadMarking{sf::Vector2f(roadMarkingWidth, roadMarkingHeight)};
-    // Set the origin to middle top of rectangle
-    rectRoadMarking.setOrigin(rectRoadMarking.getSize().x * 0.5f , rectRoadMarking.getSize().y);
-
-
-    // * UI panels //
-    list<sf::Texture>& panelTextureList = loadTexture(list<string>{"panelBlue.png", "panelRed.png"});
-    list<sf::Sprite> panelSpriteList;
-    for (sf::Texture& texture : panelTextureList) { panelSpriteList.push_back(sf::Sprite{texture}); }
+    // One texture per archetype, the hitbox is the archetype's
+    vector<BodyType> carTypes;
+    for (const CarArchetype& archetype : carArchetypes)
+    {
+        TextureHandle texture = resources.load(archetype.textureFile);
+        if (texture.width() != archetype.width || texture.height() != archetype.height)
+        {
+            cout << archetype.textureFile << " is " << texture.width() << "x" << texture.height() << ", its archetype expects "
+                << archetype.width << "x" << archetype.height << endl;
+        }
+        carTypes.push_back({archetype.width, archetype.height, texture, texture.mask()});
+    }
 
-    // * UI hearts //
-    list<sf::Texture>& heartTextureList = loadTexture(list<string>{"heartFull.png", "heartEmpty.png"});
-    list<sf::Sprite> heartSpriteList;
-    for (sf::Texture& texture : heartTextureList) { heartSpriteList.push_back(sf::Sprite{texture}); }
 
-    // * UI Text //
-    sf::Font font;
-    if (!font.loadFromFile("fonts/Super Cartoon.ttf"))
+    // * Initialize World //
+    World world{WorldSettings{}, windowSize, playerType, carTypes};
+    // Get seed for randomizer
+    world.reserveCars(world.settings.carsMaxAmountToWin());
+    world.reset((std::uint64_t)time(nullptr));
+
+    // * Initialize Autopilot //
+    ThreadPool threadPool;
+    Autopilot autopilot{world, threadPool};
+
+
+    // * Rendering //
+    WindowSurface surface{window};
+    Renderer renderer{resources, windowSize};
+    // The scene is drawn here at a scale that keeps drawing within 90% of the frame time, the HUD on the window
+    // * Only drawing and display count, a slow simulation or autopilot step can't be helped by a lower resolution
+    ScaledSurface sceneSurface{window.getSize().x, window.getSize().y};
+    ResolutionScaler resolutionScaler{900.0f / (targetFrameRate > 0.0f ? targetFrameRate : 60.0f)};
+    // Transient data of the current frame: the autopilot's snapshot and scores, the HUD text
+    FrameArena frameArena;
+    // Crash, exhaust and dodge effects, the pool is allocated here once
+    ParticleSystem particles;
+    // Heap allocations per frame, only counted in builds with SPEEDRACER_TRACK_ALLOCATIONS
+    FrameAllocations frameAllocations;
+
+    ResourceManager::MemoryUsage textureMemory = resources.memoryUsage();
+    cout << "Loaded " << textureMemory.textureCount << " textures: " << textureMemory.gpuBytes / 1024 << " KiB on the GPU, "
+        << textureMemory.maskBytes / 1024 << " KiB of collision masks, " << textureMemory.entryBytes << " bytes of texture entries" << endl;
+
+
+    // * Audio //
+    // Only made when the game isn't muted, a muted game doesn't mix or stream anything
+    unique_ptr<AudioMixer> audioMixer;
+    unique_ptr<AudioStream> audioStream;
+    if (!muted)
     {
-        cout << "Could not find font file" << endl;
+        audioMixer = make_unique<AudioMixer>();
+        audioStream = make_unique<AudioStream>(*audioMixer);
+        audioStream->play();
     }
-    sf::Text text{"", font};
-    text.setCharacterSize(36);
-    text.setFillColor(sf::Color::White);
-    text.setOutlineColor(sf::Color::Black);
-    text.setOutlineThickness(5.0f);
 
 
-    // Set up clock for deltaTime
-    sf::Clock clock;
+    // * Input //
+    InputSampler inputSampler;
+    LatencyCounter latencyCounter;
+    // The held inputs (ActionBit flags)
+    uint8_t held = 0;
 
-    float score = 0.0f;
-    int carsDodged = 0;
+    // Set up frame time for deltaTime
+    int64_t lastFrameTime = InputSampler::now();
 
-    bool holdLeft = false;
-    bool holdRight = false;
-    bool holdUp = false;
-    bool holdDown = false;
+    // * Game state //
+    GameStateMachine game;
+    bool wasIdle = false;
+    // The idle states only draw when they start and when the window asks for it
+    bool redraw = false;
 
-    bool gameOver = false;
+    // Draws the world as it is, without stepping it
+    auto drawFrame = [&]()
+    {
+        if (dynamicResolution)
+        {
+            sceneSurface.setScale(resolutionScaler.scale());
+            renderer.drawScene(sceneSurface, world, &particles);
+            sceneSurface.display();
+
+            // Covers the whole window, so it doesn't need a clear
+            sceneSurface.present(surface);
+            renderer.drawOverlay(surface, world, frameArena);
+        }
+        else { renderer.draw(surface, world, frameArena, &particles); }
+    };
 
     while(window.isOpen())
     {
+        // Idle, sleep until the next window event instead of polling
         sf::Event event{};
-        while (window.pollEvent(event))
+        bool hasEvent = game.idle() && !redraw ? window.waitEvent(event) : window.pollEvent(event);
+        for (; hasEvent; hasEvent = window.pollEvent(event))
         {
             if (event.type == sf::Event::Closed) window.close();
 
-            // * Player Inputs //
+            // The movement keys are sampled by inputSampler, a game in a window without focus is paused
+            if (event.type == sf::Event::LostFocus) { inputSampler.focused = false; game.pause(); }
+            if (event.type == sf::Event::GainedFocus) { inputSampler.focused = true; redraw = true; }
+            if (event.type == sf::Event::Resized) redraw = true;
+
             if (event.type == sf::Event::KeyPressed)
             {
                 if (event.key.code == sf::Keyboard::Escape) window.close();
-
-                if (event.key.code == sf::Keyboard::A) holdLeft = true;
-                if (event.key.code == sf::Keyboard::D) holdRight = true;
-                if (event.key.code == sf::Keyboard::W) holdUp = true;
-                if (event.key.code == sf::Keyboard::S) holdDown = true;
-            }
-
-            if (event.type == sf::Event::KeyReleased)
-            {
-                if (event.key.code == sf::Keyboard::A) holdLeft = false;
-                if (event.key.code == sf::Keyboard::D) holdRight = false;
-                if (event.key.code == sf::Keyboard::W) holdUp = false;
-                if (event.key.code == sf::Keyboard::S) holdDown = false;
+                if (event.key.code == sf::Keyboard::P) autopilotEnabled = !autopilotEnabled;
+                if (event.key.code == sf::Keyboard::Space) game.togglePause();
+                if (event.key.code == sf::Keyboard::R) game.restart();
             }
         }
+        if (!window.isOpen()) { break; }
 
-        if (!gameOver)
+        // Going idle stops the sampling and the sound, coming back starts the frame timing over
+        // so the idle time isn't simulated as one long frame
+        if (game.idle() != wasIdle)
         {
-            // Get deltaTime and restart clock
-            float deltaTime = clock.restart().asSeconds();
-
-            // Increase difficulty by the amount traveled, this increases the maximum amount of cars
-            carsMaxAmount = carsStartMaxAmount + (int)(-player.pos->y / diffIncrDistance);
-
-            // Score counter (carsDodged + amountTraveled)
-            score = carsDodged * scoreForDodging + -player.pos->y * scoreForTravel;
-
-            // Get cameraPosition
-            cameraPosition.y = player.pos->y + cameraVerticalOffset;
-
-
-            // * Draw Background //
-            window.clear(gray);
-            
-            // Draw white stripes
-            for (int i = 0; i < roadMarkingLineAmount + 2 ; i++)
+            wasIdle = game.idle();
+            inputSampler.setActive(!wasIdle);
+            if (wasIdle)
             {
-                float distanceBetweenOrigin = rectRoadMarking.getSize().y + roadMarkingdistance;
-                for (int j = 0; j < windowSize.y / rectRoadMarking.getSize().y * 0.5f; j++)
-                {
-                    rectRoadMarking.setPosition(windowSize.x / (roadMarkingLineAmount + 1) * i, 
-                        j * distanceBetweenOrigin - ((int)cameraPosition.y % (int)distanceBetweenOrigin));
-                    window.draw(rectRoadMarking);
-                }
+                if (audioStream) { audioStream->pause(); }
+                redraw = true;
             }
-
-
-            // * Spawn cars //
-            if (carsSpawnTimer >= carsDesiredSpawnTime)
+            else
             {
-                if (carsAmount < carsMaxAmount)
-                {
-                    carInitializer(carTextureList, cameraPosition.y);
-
-                    // Reset timer
-                    carsSpawnTimer = 0.0f;
-                    carsDesiredSpawnTime = carsMaxSpawnTime / MyMathLib::max(carsMaxAmount - carsAmount, 1);
-                }
+                if (audioStream) { audioStream->play(); }
+                lastFrameTime = InputSampler::now();
+                framePacer.resume();
             }
-            else { carsSpawnTimer += deltaTime; }
+        }
 
+        // Everything in the arena is from the last frame
+        frameArena.reset();
 
-            // * Update rigidBody objects //
-            for (auto it = rbList.begin(); it != rbList.end(); it++)
+        if (game.idle())
+        {
+            if (redraw)
             {
-                RigidBody& rbObject = **it;
-
-                if (rbObject.faction == Faction::PLAYER) { continue; }
+                drawFrame();
+                if (game.state() == GameState::PAUSED) { renderer.drawPaused(surface); }
+                surface.display();
+                redraw = false;
+            }
+            continue;
+        }
 
-                // Check if rbObject is dead
-                if (!rbObject.update(rbList, windowSize, window, cameraPosition, deltaTime))
-                {
-                    score += 10.0f;
-                    it = rbList.erase(it);
-                    delete &rbObject;
-                    carsAmount--;
-                    carsDodged++;
+        // Same window, textures and threads, only the world starts over
+        if (game.state() == GameState::RESTARTING)
+        {
+            world.reset((std::uint64_t)time(nullptr));
+            game.restarted();
+            cout << "Restarted" << endl;
+        }
 
-                    it--;
-                }
-            }
+        frameAllocations.frameStarted();
+        inputSampler.poll();
 
+        // Get deltaTime and split it into simulation steps
+        int64_t frameTime = InputSampler::now();
+        float deltaTime = MyMathLib::min((frameTime - lastFrameTime) / 1000000.0f, maxSubsteps * maxSubstepTime);
+        int substeps = MyMathLib::clamp((int)MyMathLib::ceil(deltaTime / maxSubstepTime), 1, maxSubsteps);
 
-            // * Update Player // 
-            player.movementLogic(holdLeft, holdRight, holdUp, holdDown, deltaTime);
+        uint8_t autopilotInput = autopilotEnabled ? autopilot.update(world, deltaTime, frameArena) : 0;
 
-            // If player gets hit
-            if (player.update(rbList, windowSize, window, cameraPosition, deltaTime))
-            {
-                player.hit = false; // Reset the hit boolean
-                gameOver = player.health <= 0;
-            }
+        for (int i = 0; i < substeps; i++)
+        {
+            // Apply the input events from before the start of this step
+            int64_t substepStart = lastFrameTime + (frameTime - lastFrameTime) * i / substeps;
+            held = inputSampler.apply(substepStart, held, [&](const InputEvent& inputEvent)
+                { latencyCounter.eventApplied(inputEvent.timestamp); });
 
+            uint8_t input = autopilotEnabled ? autopilotInput : held;
+            world.step(input & ACTION_LEFT, input & ACTION_RIGHT, input & ACTION_UP, input & ACTION_DOWN, deltaTime / substeps);
+        }
+        lastFrameTime = frameTime;
 
-            // * Draw UI //
-            for (int i = 1; i <= player.maxHealth; i++)
-            {
-                sf::Sprite sprite;
-                if (i <= player.health) { sprite = heartSpriteList.front(); }  // Get full heart sprite
-                else { sprite = heartSpriteList.back(); }   // Get empty heart sprite
+        if (world.gameOver)
+        {
+            cout << "Game Over" << endl;
+            game.gameEnded();
+        }
+        if (audioMixer) { audioMixer->update(world); }
+        particles.update(world, deltaTime);
 
-                sprite.setPosition(windowSize.x - i * ((float)sprite.getTexture()->getSize().x + 10.0f) - 15.0f, 20.0f);
-                window.draw(sprite);
-            }
+        int64_t drawTime = InputSampler::now();
+        drawFrame();
+        surface.display();
 
-            text.setString("Score: " + to_string(MyMathLib::round(score, 2)));
-            text.setPosition(20.0f, 20.0f);
-            window.draw(text);
+        int64_t displayTime = InputSampler::now();
+        latencyCounter.frameDisplayed(displayTime);
+        resolutionScaler.frameFinished((displayTime - drawTime) / 1000.0f);
+        frameAllocations.frameEnded();
 
+        framePacer.wait();
+    }
 
-            // When player is dead
-            if (gameOver)
-            {
-                cout << "Game Over" << endl;
-
-                sf::Sprite sprite;
-                string additionalText;
-                
-                // Show win or lose screen depending on score
-                if (score >= winCondition)
-                {
-                    text.setString("You Win!");
-                    additionalText = "Your score reached past " + to_string((int)winCondition);
-                    sprite = panelSpriteList.front();
-                }
-                else
-                {
-                    text.setString("You Lose!");
-                    additionalText = "Your score didn't reach past " + to_string((int)winCondition);
-                    sprite = panelSpriteList.back();
-                }
-
-                // Panel
-                sprite.setOrigin((float)sprite.getTexture()->getSize().x / 2.0f, (float)sprite.getTexture()->getSize().y / 2.0f);
-                sprite.setPosition(windowSize.x / 2, windowSize.y / 2);
-                window.draw(sprite);
-
-                // Text
-                text.setCharacterSize(72);
-                sf::FloatRect bounds = text.getLocalBounds();
-                text.setPosition((windowSize.x - bounds.width) / 2, windowSize.y / 2 - bounds.height * 1.5f);
-                window.draw(text);
-
-                text.setString(additionalText);
-                text.setCharacterSize(24);
-                bounds = text.getLocalBounds();
-                text.setPosition((windowSize.x - bounds.width) / 2, windowSize.y / 2 + bounds.height * 1.5f);
-                window.draw(text);
-            }
+    if (framePacer.targetRate() > 0.0f)
+    {
+        cout << "Frame pacing at " << framePacer.targetRate() << " Hz: average error " << framePacer.averageErrorMs()
+            << " ms, max " << framePacer.maxErrorMs() << " ms over " << framePacer.frameCount() << " frames" << endl;
+        cout << "Last " << framePacer.recentFrameCount() << " frames: median error " << framePacer.recentErrorPercentileMs(0.5f)
+            << " ms, p99 " << framePacer.recentErrorPercentileMs(0.99f) << " ms, max " << framePacer.recentErrorPercentileMs(1.0f) << " ms" << endl;
+    }
 
-            window.display();
-        }
+    if (dynamicResolution)
+    {
+        cout << "Scene resolution: average scale " << resolutionScaler.averageScale() << ", " << resolutionScaler.changes()
+            << " changes, average frame " << resolutionScaler.averageFrameMs() << " ms" << endl;
     }
 
-    // * Delete RigidBody Objects //
-    for (int i = (int)rbList.size(); i > 0; i--)
+    if (AllocationTracker::enabled())
     {
-        auto it = rbList.begin();
-        delete *it;
-        rbList.erase(it);
+        cout << "Heap allocations per frame: average " << frameAllocations.averageAllocations() << " (" << frameAllocations.averageBytes()
+            << " bytes), max " << frameAllocations.maxAllocations() << " (" << frameAllocations.maxBytes() << " bytes) over "
+            << frameAllocations.frameCount() << " frames" << endl;
     }
 
+    cout << "Input latency (input to display): average " << latencyCounter.averageMs() << " ms, max "
+        << latencyCounter.maxMs() << " ms over " << latencyCounter.count() << " inputs" << endl;
+
     return 0;
 }
\ No newline at end of file
@@ -9,11 +9,11 @@ namespace MyMathLib
 
     int min(int a, int b) { return a <= b ? a : b; }
     float min(float a, float b) { return a <= b ? a : b; }
-    Vector2 min(Vector2 vec2, float b) { return {min(vec2.x, b), min(vec2.y, b)}; }
+    Vector2 min(Vector2 vec2, Scalar b) { return {min(vec2.x, b), min(vec2.y, b)}; }
 
     int max(int a, int b) { return a >= b ? a : b; }
     float max(float a, float b) { return a >= b ? a : b; }
-    Vector2 max(Vector2 vec2, float b) { return {max(vec2.x, b), max(vec2.y, b)}; }
+    Vector2 max(Vector2 vec2, Scalar b) { return {max(vec2.x, b), max(vec2.y, b)}; }
 
     int clamp(int value, int minimum, int maximum)
     {
@@ -25,7 +25,7 @@ namespace MyMathLib
         return min(max(value, minimum), maximum);
     }
 
-    Vector2 clamp(Vector2 vec2, float minimum, float maximum)
+    Vector2 clamp(Vector2 vec2, Scalar minimum, Scalar maximum)
     {
         return {clamp(vec2.x, minimum, maximum), clamp(vec2.y, minimum, maximum)};
     }
@@ -131,4 +131,12 @@ namespace MyMathLib
         
         return --potentialExp;
     }
+
+    // * Fixed point //
+    Fixed abs(Fixed value) { return value < 0 ? -value : value; }
+    Fixed min(Fixed a, Fixed b) { return a <= b ? a : b; }
+    Fixed max(Fixed a, Fixed b) { return a >= b ? a : b; }
+    Fixed clamp(Fixed value, Fixed minimum, Fixed maximum) { return min(max(value, minimum), maximum); }
+    Fixed floor(Fixed value) { return Fixed::fromRaw(value.raw & ~(Fixed::one - 1)); }
+    Fixed sqrt(Fixed radicant) { return Fixed::sqrt(radicant); }
 }
\ No newline at end of file
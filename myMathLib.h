@@ -13,15 +13,15 @@ namespace MyMathLib
 
     int min(int a, int b);
     float min(float a, float b);
-    Vector2 min(Vector2 vec2, float b);
+    Vector2 min(Vector2 vec2, Scalar b);
 
     int max(int a, int b);
     float max(float a, float b);
-    Vector2 max(Vector2 vec2, float b);
+    Vector2 max(Vector2 vec2, Scalar b);
 
     int clamp(int value, int minimum, int maximum);
     float clamp(float value, float minimum, float maximum);
-    Vector2 clamp(Vector2 vec2, float minimum, float maximum);
+    Vector2 clamp(Vector2 vec2, Scalar minimum, Scalar maximum);
 
     float fmod(float numer, float denom);
     float floor(float value);
@@ -36,4 +36,13 @@ namespace MyMathLib
 
     float exp(float value);
     int log(float base, float value);
+
+    // * Fixed point //
+    // Same as their float versions, but exact (see fixed.h)
+    Fixed abs(Fixed value);
+    Fixed min(Fixed a, Fixed b);
+    Fixed max(Fixed a, Fixed b);
+    Fixed clamp(Fixed value, Fixed minimum, Fixed maximum);
+    Fixed floor(Fixed value);
+    Fixed sqrt(Fixed radicant);
 }
\ No newline at end of file
@@ -0,0 +1,225 @@
+#include "particleSystem.h"
+
+#include "myMathLib.h"
+#include "renderSurface.h"
+#include "world.h"
+
+// SSE2 is always there on x86-64, other targets use the scalar loop (which the compiler may still vectorize)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PARTICLES_SSE2
+#include <emmintrin.h>
+#endif
+
+const ParticleEmitter ParticleSystem::crashSparks{{0.0f, 0.0f}, 700.0f, 0.2f, 0.6f, 4.0f, -3.0f, sf::Color{255, 200, 80}};
+const ParticleEmitter ParticleSystem::crashSmoke{{0.0f, 0.0f}, 150.0f, 0.6f, 1.2f, 10.0f, 40.0f, sf::Color{90, 90, 90, 160}};
+const ParticleEmitter ParticleSystem::exhaust{{0.0f, 0.0f}, 40.0f, 0.3f, 0.6f, 4.0f, 12.0f, sf::Color{150, 150, 150, 110}};
+const ParticleEmitter ParticleSystem::dodge{{0.0f, 0.0f}, 60.0f, 0.25f, 0.5f, 3.0f, 0.0f, sf::Color{255, 255, 255, 200}};
+
+ParticleSystem::ParticleSystem(int capacity, const ParticleSettings& settings) :
+    settings(settings), particleCapacity(MyMathLib::max(capacity, 1)), random(0x5eed)
+{
+    x.resize(particleCapacity);
+    y.resize(particleCapacity);
+    vx.resize(particleCapacity);
+    vy.resize(particleCapacity);
+    life.resize(particleCapacity);
+    fade.resize(particleCapacity);
+    size.resize(particleCapacity);
+    growth.resize(particleCapacity);
+    colors.resize(particleCapacity);
+    vertices.resize((size_t)particleCapacity * 4);
+}
+
+void ParticleSystem::update(const World& world, float deltaTime)
+{
+    simulate(deltaTime);
+
+    const Player* player = world.bodies.player;
+    if (player == nullptr) { return; }
+
+    // * Events //
+    // The dodge streaks come off the player, the car that was dodged is already behind the camera
+    sf::Vector2f playerPosition{(float)player->pos.x, (float)player->pos.y};
+    sf::Vector2f playerVelocity{(float)player->vel.x, (float)player->vel.y};
+    eventCursor = world.events.read(eventCursor, [&](const WorldEvent& event)
+    {
+        sf::Vector2f position{(float)event.position.x, (float)event.position.y};
+        switch (event.type)
+        {
+            // The particles of the last game are gone with it
+            case WorldEvent::Type::GAME_STARTED:
+                clear();
+                break;
+            case WorldEvent::Type::PLAYER_HIT:
+                emit(crashSparks, position, sf::Vector2f{}, settings.crashSparks);
+                emit(crashSmoke, position, sf::Vector2f{}, settings.crashSmoke);
+                break;
+            case WorldEvent::Type::CAR_DODGED:
+                emit(dodge, playerPosition, playerVelocity * 0.5f, settings.dodgeStreaks);
+                break;
+            default:
+                break;
+        }
+    });
+
+
+    // * Exhaust //
+    exhaustCarry += settings.exhaustRate * deltaTime;
+    int puffs = (int)exhaustCarry;
+    if (puffs == 0) { return; }
+    exhaustCarry -= (float)puffs;
+
+    float viewTop = (float)world.cameraPosition.y - settings.exhaustViewMargin;
+    float viewBottom = (float)world.cameraPosition.y + (float)world.windowSize.y + settings.exhaustViewMargin;
+
+    emitExhaust(*player, puffs);
+    for (const Car* car : world.bodies.cars)
+    {
+        float carY = (float)car->pos.y;
+        if (carY >= viewTop && carY <= viewBottom) { emitExhaust(*car, puffs); }
+    }
+}
+
+// From the back of the body, slower than the body so the puffs trail behind it
+void ParticleSystem::emitExhaust(const RigidBody& body, int puffs)
+{
+    float velocityY = (float)body.vel.y;
+    float back = velocityY >= 0.0f ? -0.5f : 0.5f;
+    sf::Vector2f position{(float)body.pos.x, (float)body.pos.y + back * body.height};
+    emit(exhaust, position, sf::Vector2f{(float)body.vel.x, velocityY} * 0.6f, puffs);
+}
+
+void ParticleSystem::emit(const ParticleEmitter& emitter, sf::Vector2f position, sf::Vector2f velocity, int count)
+{
+    for (int n = 0; n < count; n++)
+    {
+        if (particleCount == particleCapacity) { droppedCount += count - n; return; }
+
+        // A random velocity within a circle of radius spread
+        float randomX, randomY;
+        do
+        {
+            randomX = random.range(-1.0f, 1.0f);
+            randomY = random.range(-1.0f, 1.0f);
+        } while (randomX * randomX + randomY * randomY > 1.0f);
+
+        float lifetime = random.range(emitter.lifetimeMin, emitter.lifetimeMax);
+
+        int i = particleCount++;
+        x[i] = position.x;
+        y[i] = position.y;
+        vx[i] = velocity.x + emitter.drift.x + randomX * emitter.spread;
+        vy[i] = velocity.y + emitter.drift.y + randomY * emitter.spread;
+        life[i] = lifetime;
+        fade[i] = 1.0f / lifetime;
+        size[i] = emitter.size;
+        growth[i] = emitter.growth;
+        colors[i] = emitter.color;
+    }
+}
+
+void ParticleSystem::simulate(float deltaTime)
+{
+    float keep = MyMathLib::max(1.0f - settings.drag * deltaTime, 0.0f);
+    bool anyDead = false;
+    int i = 0;
+
+#ifdef PARTICLES_SSE2
+    const __m128 time = _mm_set1_ps(deltaTime);
+    const __m128 keepVelocity = _mm_set1_ps(keep);
+    const __m128 zero = _mm_setzero_ps();
+    int deadMask = 0;
+    for (; i + 4 <= particleCount; i += 4)
+    {
+        __m128 velocityX = _mm_loadu_ps(&vx[i]);
+        __m128 velocityY = _mm_loadu_ps(&vy[i]);
+        _mm_storeu_ps(&x[i], _mm_add_ps(_mm_loadu_ps(&x[i]), _mm_mul_ps(velocityX, time)));
+        _mm_storeu_ps(&y[i], _mm_add_ps(_mm_loadu_ps(&y[i]), _mm_mul_ps(velocityY, time)));
+        _mm_storeu_ps(&vx[i], _mm_mul_ps(velocityX, keepVelocity));
+        _mm_storeu_ps(&vy[i], _mm_mul_ps(velocityY, keepVelocity));
+
+        __m128 lifeLeft = _mm_sub_ps(_mm_loadu_ps(&life[i]), time);
+        _mm_storeu_ps(&life[i], lifeLeft);
+        deadMask |= _mm_movemask_ps(_mm_cmple_ps(lifeLeft, zero));
+    }
+    anyDead = deadMask != 0;
+#endif
+
+    // The particles that don't fill a group of 4 (or all of them without SSE2)
+    for (; i < particleCount; i++)
+    {
+        x[i] += vx[i] * deltaTime;
+        y[i] += vy[i] * deltaTime;
+        vx[i] *= keep;
+        vy[i] *= keep;
+        life[i] -= deltaTime;
+        if (life[i] <= 0.0f) { anyDead = true; }
+    }
+
+    if (anyDead) { removeDead(); }
+}
+
+void ParticleSystem::clear() { particleCount = 0; }
+
+// The last particle takes the place of a dead one, so the order of the particles changes but no gaps are left
+void ParticleSystem::removeDead()
+{
+    int i = 0;
+    while (i < particleCount)
+    {
+        if (life[i] > 0.0f) { i++; continue; }
+        particleCount--;
+        moveParticle(particleCount, i);
+    }
+}
+
+void ParticleSystem::moveParticle(int from, int to)
+{
+    x[to] = x[from];
+    y[to] = y[from];
+    vx[to] = vx[from];
+    vy[to] = vy[from];
+    life[to] = life[from];
+    fade[to] = fade[from];
+    size[to] = size[from];
+    growth[to] = growth[from];
+    colors[to] = colors[from];
+}
+
+int ParticleSystem::buildVertices(const Vector2& camPos)
+{
+    float cameraX = (float)camPos.x;
+    float cameraY = (float)camPos.y;
+
+    sf::Vertex* vertex = vertices.data();
+    for (int i = 0; i < particleCount; i++, vertex += 4)
+    {
+        // 1 when the particle is new, 0 when it dies
+        float left = life[i] * fade[i];
+        float half = MyMathLib::max((size[i] + growth[i] * (1.0f - left)) * 0.5f, 0.5f);
+        float screenX = x[i] - cameraX;
+        float screenY = y[i] - cameraY;
+
+        sf::Color color = colors[i];
+        color.a = (sf::Uint8)(color.a * left);
+
+        vertex[0].position = sf::Vector2f{screenX - half, screenY - half};
+        vertex[1].position = sf::Vector2f{screenX + half, screenY - half};
+        vertex[2].position = sf::Vector2f{screenX + half, screenY + half};
+        vertex[3].position = sf::Vector2f{screenX - half, screenY + half};
+        vertex[0].color = color;
+        vertex[1].color = color;
+        vertex[2].color = color;
+        vertex[3].color = color;
+    }
+
+    return particleCount * 4;
+}
+
+void ParticleSystem::draw(RenderSurface& surface, const Vector2& camPos)
+{
+    int vertexCount = buildVertices(camPos);
+    if (vertexCount == 0) { return; }
+
+    surface.draw(vertices.data(), (size_t)vertexCount, sf::Quads);
+}
\ No newline at end of file
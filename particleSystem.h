@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+#include "random.h"
+#include "vector2.h"
+
+class World;
+class RigidBody;
+class RenderSurface;
+
+struct ParticleSettings
+{
+    // Exhaust puffs per second for every vehicle in view
+    float exhaustRate = 40.0f;
+    // Vehicles further outside of the view than this don't emit exhaust
+    float exhaustViewMargin = 200.0f;
+
+    int crashSparks = 160;
+    int crashSmoke = 48;
+    int dodgeStreaks = 32;
+
+    // The share of the velocity that particles lose per second
+    float drag = 2.5f;
+};
+
+// How the particles of a burst start
+// * The velocity is the velocity given to emit() plus drift, plus a random velocity of up to spread in any direction
+struct ParticleEmitter
+{
+    sf::Vector2f drift;
+    float spread;
+    float lifetimeMin;
+    float lifetimeMax;
+    float size;         // Width of the square at the start
+    float growth;       // Width added over the lifetime
+    sf::Color color;    // The alpha fades to 0 over the lifetime
+};
+
+// * Particle system //
+// Crash sparks and smoke, exhaust puffs and dodge streaks, purely visual so the world (and its snapshots) never see them
+// * The particles are structure of arrays in a fixed capacity, so the update runs over plain float arrays
+//   four particles at a time (SSE2, with a scalar fallback), and nothing is allocated after construction
+// * Dead particles are replaced by the last one, so the live particles always are the first count()
+// * All particles are one vertex array of quads, drawn with a single draw call
+// ! Bursts are cut short when the pool is full, the dropped particles are counted
+class ParticleSystem
+{
+    public:
+        static const ParticleEmitter crashSparks;
+        static const ParticleEmitter crashSmoke;
+        static const ParticleEmitter exhaust;
+        static const ParticleEmitter dodge;
+
+        ParticleSystem(int capacity = 32768, const ParticleSettings& settings = ParticleSettings{});
+        ParticleSystem(const ParticleSystem& other) = delete;
+        ParticleSystem& operator=(const ParticleSystem& other) = delete;
+
+        const ParticleSettings settings;
+
+        // Once per frame: emits for what happened in the world since the last update, then moves the particles
+        void update(const World& world, float deltaTime);
+
+        void emit(const ParticleEmitter& emitter, sf::Vector2f position, sf::Vector2f velocity, int count);
+        void simulate(float deltaTime);
+        void clear();
+
+        void draw(RenderSurface& surface, const Vector2& camPos);
+        // Fills the vertex array and returns its vertex count, draw() does this itself
+        int buildVertices(const Vector2& camPos);
+
+        int count() const { return particleCount; }
+        int capacity() const { return particleCapacity; }
+        int droppedParticles() const { return droppedCount; }
+
+    private:
+        int particleCapacity;
+        int particleCount = 0;
+        int droppedCount = 0;
+
+        // * Particles //
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> vx;
+        std::vector<float> vy;
+        std::vector<float> life;        // Seconds left
+        std::vector<float> fade;        // 1 / lifetime, life * fade goes from 1 to 0
+        std::vector<float> size;
+        std::vector<float> growth;
+        std::vector<sf::Color> colors;
+
+        std::vector<sf::Vertex> vertices;
+
+        Random random;
+
+        // * Events //
+        std::uint64_t eventCursor = 0;  // The next world event to emit for (see WorldEvents)
+        float exhaustCarry = 0.0f;      // Puffs that don't make up a whole one yet
+
+        void emitExhaust(const RigidBody& body, int puffs);
+        void removeDead();
+        void moveParticle(int from, int to);
+};
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "pixelMask.h"
+#include "myMathLib.h"
+
+PixelMask::PixelMask(const sf::Image& image, std::uint8_t alphaThreshold) :
+    width((int)image.getSize().x), height((int)image.getSize().y), wordsPerRow((width + 63) / 64),
+    rows((std::size_t)wordsPerRow * height, 0), spans(height, Span{(std::int16_t)width, -1})
+{
+    for (int y = 0; y < height; y++)
+    {
+        std::uint64_t* row = &rows[(std::size_t)y * wordsPerRow];
+        Span& span = spans[y];
+        for (int x = 0; x < width; x++)
+        {
+            if (image.getPixel(x, y).a >= alphaThreshold)
+            {
+                row[x / 64] |= std::uint64_t{1} << (x % 64);
+                if (x < span.first) { span.first = (std::int16_t)x; }
+                span.last = (std::int16_t)x;
+            }
+        }
+    }
+}
+
+bool PixelMask::test(int x, int y) const
+{
+    if (x < 0 || y < 0 || x >= width || y >= height) { return false; }
+    return (rows[(std::size_t)y * wordsPerRow + x / 64] >> (x % 64)) & 1;
+}
+
+std::uint64_t PixelMask::bitsAt(const std::uint64_t* row, int x) const
+{
+    int word = x / 64;
+    int shift = x % 64;
+    std::uint64_t bits = row[word] >> shift;
+    if (shift != 0 && word + 1 < wordsPerRow) { bits |= row[word + 1] << (64 - shift); }
+    return bits;
+}
+
+bool PixelMask::overlaps(const PixelMask& other, int offsetX, int offsetY) const
+{
+    if (empty() || other.empty()) { return false; }
+
+    // The overlapping region in this mask's pixels
+    int left = MyMathLib::max(0, offsetX);
+    int right = MyMathLib::min(width, offsetX + other.width);
+    int top = MyMathLib::max(0, offsetY);
+    int bottom = MyMathLib::min(height, offsetY + other.height);
+
+    for (int y = top; y < bottom; y++)
+    {
+        // Only the pixels where both rows have something
+        const Span& span = spans[y];
+        const Span& otherSpan = other.spans[y - offsetY];
+        int spanLeft = MyMathLib::max(MyMathLib::max((int)span.first, otherSpan.first + offsetX), left);
+        int spanRight = MyMathLib::min(MyMathLib::min(span.last + 1, otherSpan.last + 1 + offsetX), right);
+        if (spanLeft >= spanRight) { continue; }
+
+        const std::uint64_t* row = &rows[(std::size_t)y * wordsPerRow];
+        const std::uint64_t* otherRow = &other.rows[(std::size_t)(y - offsetY) * other.wordsPerRow];
+
+        for (int x = spanLeft; x < spanRight; x += 64)
+        {
+            std::uint64_t bits = bitsAt(row, x) & other.bitsAt(otherRow, x - offsetX);
+            // Ignore the pixels past the overlap in the last word
+            if (spanRight - x < 64) { bits &= (std::uint64_t{1} << (spanRight - x)) - 1; }
+            if (bits != 0) { return true; }
+        }
+    }
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+// 1 bit per pixel of an image: set where the pixel is opaque enough to be hit
+// * Every row is packed into 64-bit words (bit i of word w is pixel x = w * 64 + i)
+// * Built once when a texture is loaded, collisions test 64 pixels per AND
+// * Every row also keeps the span from its first to its last set pixel, rows whose spans miss each other are skipped
+class PixelMask
+{
+    public:
+        PixelMask() = default;
+        PixelMask(const sf::Image& image, std::uint8_t alphaThreshold = 128);
+
+        int width = 0;
+        int height = 0;
+
+        bool empty() const { return rows.empty(); }
+        bool test(int x, int y) const;
+
+        // Whether any set pixel of both masks overlap, other's top left corner is at (offsetX, offsetY) in this mask
+        bool overlaps(const PixelMask& other, int offsetX, int offsetY) const;
+
+        std::size_t memoryUsage() const { return rows.size() * sizeof(std::uint64_t) + spans.size() * sizeof(Span); }
+
+    private:
+        struct Span { std::int16_t first; std::int16_t last; };   // first > last for an empty row
+
+        int wordsPerRow = 0;
+        std::vector<std::uint64_t> rows;
+        std::vector<Span> spans;
+
+        // The 64 pixels of a row starting at x, pixels past the end of the row are 0
+        std::uint64_t bitsAt(const std::uint64_t* row, int x) const;
+};
\ No newline at end of file
@@ -1,27 +1,33 @@
 #include "player.h"
+#include "bodyGroups.h"
 
 Player::Player(int id, int width, int height, float maxVel, float forceAmountPerFrame,
     float frictionCoefficient, float mass, int maxHealth, float maxIntangibleTime) :
-        RigidBody{id ,width, height, maxVel, forceAmountPerFrame, frictionCoefficient, mass, Faction::PLAYER},
-        health(maxHealth) ,maxHealth(maxHealth), maxIntangibleTime(maxIntangibleTime),
-        intangibleTimer(maxIntangibleTime) {};
+        RigidBody{id ,width, height, forceAmountPerFrame, Faction::PLAYER},
+        health(maxHealth) ,maxHealth(maxHealth), maxVel(maxVel), frictionCoefficient(frictionCoefficient), mass(mass),
+        intangibleTicks(ticksFor(maxIntangibleTime, tickRate)) {};
 
-Player::~Player() = default;
+Player::~Player() { if (timers != nullptr) { timers->cancel(intangibleTimer); } }
 Player::Player(const Player& other) : RigidBody{other}
 {
     health = other.health;
     maxHealth = other.maxHealth;
     hit = other.hit;
-    maxIntangibleTime = other.maxIntangibleTime;
-    intangibleTimer = other.intangibleTimer;
+    maxVel = other.maxVel;
+    frictionCoefficient = other.frictionCoefficient;
+    mass = other.mass;
+    timers = other.timers;
+    intangibleTicks = other.intangibleTicks;
+    intangibleUntil = other.intangibleUntil;
+    // The timer still ends the intangibility of the other player, this one stays intangible
 };
 
 void Player::movementLogic(bool left, bool right, bool up, bool down, float deltaTime)
 {
-    float horizontalForce = left ? -forceAmountPerFrame : right ? forceAmountPerFrame : 0.0f;
+    Scalar horizontalForce = left ? -forceAmountPerFrame : right ? forceAmountPerFrame : Scalar{0.0f};
     // Prevent player from moving backwards by checking if the velocity is negative
     // Added an additional multiplier for decreasing movement, so the player can slow down quickly when needed
-    float verticalForce = up ? -forceAmountPerFrame : down && vel->y < 0.0f ? forceAmountPerFrame * 3.0f : 0.0f;
+    Scalar verticalForce = up ? -forceAmountPerFrame : down && vel.y < 0.0f ? forceAmountPerFrame * 3.0f : Scalar{0.0f};
 
     if (horizontalForce != 0.0f || verticalForce != 0.0f)
     {
@@ -29,34 +35,72 @@ void Player::movementLogic(bool left, bool right, bool up, bool down, float delt
     }
 }
 
-bool Player::update(std::list<RigidBody*>& rbList, Vector2& windowSize, sf::RenderWindow& window, Vector2& camPos, float deltaTime)
+bool Player::update(std::list<RigidBody*>& rbList, Vector2& windowSize, Vector2& camPos, float deltaTime)
 {
-    if (intangible)
-    {
-        intangibleTimer += deltaTime;
-        if (intangibleTimer >= maxIntangibleTime) { intangible = false; }
-    }
+    BodyList bodies{rbList};
+    updateNextPos<RigidBody>(bodies, windowSize, camPos, deltaTime);
 
-    updateNextPos(rbList, windowSize, camPos, deltaTime);
-
-    Vector2 screenSpace = *pos - camPos;
-    sprite->setPosition(screenSpace.x, screenSpace.y);
+    return hit;
+}
 
-    // Alternate drawing the player when intangible
-    if (this->intangible && (int)(this->intangibleTimer * 10.0f) % 2 != 0) { }
-    else { window.draw(*sprite); }
+bool Player::update(BodyGroups& bodies, Vector2& windowSize, Vector2& camPos, float deltaTime)
+{
+    updateNextPos<Player>(bodies, windowSize, camPos, deltaTime);
 
     return hit;
 }
 
+// A timer that was still running is replaced, a delay of 0 ends on the next tick like any timer
+void Player::startIntangibility(std::uint64_t ticks)
+{
+    timers->cancel(intangibleTimer);
+    intangible = true;
+    intangibleUntil = timers->now() + (ticks > 0 ? ticks : 1);
+    intangibleTimer = timers->schedule(ticks, &Player::onIntangibilityEnded, this);
+}
+
+void Player::onIntangibilityEnded(void* player) { static_cast<Player*>(player)->intangible = false; }
+
+void Player::draw(RenderSurface& surface, Vector2& camPos)
+{
+    // Alternate drawing the player every tenth of a second when intangible
+    std::uint64_t sinceHit = timers->now() + intangibleTicks - intangibleUntil;
+    if (this->intangible && sinceHit * 10 / (std::uint64_t)tickRate % 2 != 0) { }
+    else { RigidBody::draw(surface, camPos); }
+}
+
 // Keep the player within the window horizontally
-void Player::onHorizontalWindowHit(Vector2& currentVel, Vector2& nextPos, float windowPos, float camHorizontalPos)
+void Player::onHorizontalWindowHit(Vector2& currentVel, Vector2& nextPos, Scalar windowPos, Scalar camHorizontalPos)
 {
-    currentVel.x = 0.0f;
+    currentVel.x = Scalar{0.0f};
     float halfWidth = width * 0.5f;
     nextPos.x = windowPos <= 0.0f ? windowPos + halfWidth : windowPos - halfWidth ;
 }
 
+void Player::saveState(BodyState& state) const
+{
+    RigidBody::saveState(state);
+    state.health = health;
+    state.hit = hit;
+    state.intangibleUntil = intangibleUntil;
+}
+
+void Player::loadState(const BodyState& state)
+{
+    RigidBody::loadState(state);
+    health = state.health;
+    hit = state.hit;
+    intangibleUntil = state.intangibleUntil;
+
+    // The timers are at the time of the state already (see World::restore)
+    timers->cancel(intangibleTimer);
+    if (intangible)
+    {
+        std::uint64_t now = timers->now();
+        intangibleTimer = timers->schedule(intangibleUntil > now ? intangibleUntil - now : 0, &Player::onIntangibilityEnded, this);
+    }
+}
+
 bool Player::onObjectCollision(RigidBody& other)
 {
     // If other object is a car and player is not intangible, damage player
@@ -64,10 +108,9 @@ bool Player::onObjectCollision(RigidBody& other)
     {
         hit = true;
         health--;
-        *vel = Vector2{};
+        vel = Vector2{};
 
-        intangibleTimer = 0.0f;
-        intangible = true;
+        startIntangibility(intangibleTicks);
 
         return true;
     }
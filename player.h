@@ -1,9 +1,14 @@
 #pragma once
 
 #include "rigidBody.h"
+#include "timerWheel.h"
 
-class Player : public RigidBody
+struct BodyGroups;
+
+class Player final : public RigidBody
 {
+    friend class RigidBody;
+
     public:
         Player(int id, int width, int height, float maxVel, float forceAmountPerFrame,
             float frictionCoefficient, float mass, int maxHealth, float maxIntangibleTime);
@@ -13,14 +18,33 @@ class Player : public RigidBody
         int health;
         int maxHealth;
         bool hit = false;   // Whether the player has been hit, is used as a return value in update()
+        // The world's timers, the intangibility after a hit is a timer in them
+        TimerWheel* timers = nullptr;
+
+        using Integrator = AnalyticFriction;
 
         void movementLogic(bool left, bool right, bool up, bool down, float deltaTime);
-        bool update(std::list<RigidBody*>& rbList, Vector2& windowSize, sf::RenderWindow& window, Vector2& camPos, float deltaTime);
+        bool update(std::list<RigidBody*>& rbList, Vector2& windowSize, Vector2& camPos, float deltaTime);
+        bool update(BodyGroups& bodies, Vector2& windowSize, Vector2& camPos, float deltaTime);
+        void draw(RenderSurface& surface, Vector2& camPos);
+
+        void saveState(BodyState& state) const;
+        void loadState(const BodyState& state);
+
+        Scalar maxVelocity() const override { return maxVel; }
+        Scalar friction() const override { return frictionCoefficient; }
+        Scalar bodyMass() const override { return mass; }
 
     private:
-        float maxIntangibleTime; // How long the player can be intangible for in seconds
-        float intangibleTimer;
+        Scalar maxVel;
+        Scalar frictionCoefficient; // Between 0.0f and 1.0f
+        Scalar mass;
+        std::uint64_t intangibleTicks;      // How long the player is intangible for after a hit
+        std::uint64_t intangibleUntil = 0;
+        TimerWheel::TimerId intangibleTimer;
 
-        void onHorizontalWindowHit(Vector2& currentVel, Vector2& nextPos, float windowPos, float camHorizontalPos);
+        void startIntangibility(std::uint64_t ticks);
+        static void onIntangibilityEnded(void* player);
+        void onHorizontalWindowHit(Vector2& currentVel, Vector2& nextPos, Scalar windowPos, Scalar camHorizontalPos);
         bool onObjectCollision(RigidBody& other);
 };
\ No newline at end of file
@@ -0,0 +1,27 @@
+#include "random.h"
+
+Random::Random(std::uint64_t seed) { this->seed(seed); }
+
+void Random::seed(std::uint64_t seed)
+{
+    // Mix the seed (splitmix64), the state is never allowed to be 0
+    std::uint64_t z = seed + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    state = (z ^ (z >> 31)) | 1ull;
+}
+
+std::uint32_t Random::next()
+{
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return (std::uint32_t)((state * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+int Random::range(int count) { return (int)(((std::uint64_t)next() * (std::uint64_t)count) >> 32); }
+
+// Uses the top 24 bits so the result is exact in a float
+float Random::range(float min, float max) { return (float)(next() >> 8) * (1.0f / 16777216.0f) * (max - min) + min; }
+
+bool Random::chance() { return (next() >> 31) != 0; }
\ No newline at end of file
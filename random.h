@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+
+// Small, self-contained randomizer (xorshift64*) so every game instance can own its own sequence
+// * Plain data, so it can be copied along with the rest of a game instance
+class Random
+{
+    public:
+        Random(std::uint64_t seed = 0);
+
+        std::uint64_t state;
+
+        void seed(std::uint64_t seed);
+
+        std::uint32_t next();
+        int range(int count);                   // Between 0 and count - 1
+        float range(float min, float max);      // Between min and max
+        bool chance();                          // 50/50
+};
\ No newline at end of file
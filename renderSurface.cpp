@@ -0,0 +1,88 @@
+#include "renderSurface.h"
+#include <iostream>
+
+// * RenderSurface //
+void RenderSurface::clear(const sf::Color& color) { target().clear(color); }
+
+void RenderSurface::draw(const sf::Drawable& drawable, const sf::RenderStates& states)
+{
+    drawCallCount++;
+    target().draw(drawable, states);
+}
+
+void RenderSurface::draw(const sf::Vertex* vertices, std::size_t vertexCount, sf::PrimitiveType type, const sf::RenderStates& states)
+{
+    drawCallCount++;
+    target().draw(vertices, vertexCount, type, states);
+}
+
+sf::Vector2u RenderSurface::size() { return target().getSize(); }
+
+
+// * WindowSurface //
+WindowSurface::WindowSurface(sf::RenderWindow& window) : window(window) {}
+
+sf::RenderTarget& WindowSurface::target() { return window; }
+
+void WindowSurface::display() { window.display(); }
+
+
+// * OffscreenSurface //
+OffscreenSurface::OffscreenSurface(unsigned width, unsigned height)
+{
+    if (!texture.create(width, height)) { std::cout << "Could not create the offscreen render texture" << std::endl; }
+}
+
+sf::RenderTarget& OffscreenSurface::target() { return texture; }
+
+void OffscreenSurface::display() { texture.display(); }
+
+bool OffscreenSurface::saveFrame(const std::string& fileName) const
+{
+    return texture.getTexture().copyToImage().saveToFile(fileName);
+}
+
+
+// * ScaledSurface //
+ScaledSurface::ScaledSurface(unsigned width, unsigned height)
+{
+    if (!texture.create(width, height)) { std::cout << "Could not create the scaled render texture" << std::endl; }
+
+    // Bilinear filtering when upscaling
+    texture.setSmooth(true);
+    sprite.setTexture(texture.getTexture());
+    setScale(1.0f);
+}
+
+sf::RenderTarget& ScaledSurface::target() { return texture; }
+
+void ScaledSurface::display() { texture.display(); }
+
+void ScaledSurface::setScale(float scale)
+{
+    renderScale = scale;
+    sf::Vector2u fullSize = texture.getSize();
+    sf::Vector2u drawnSize = renderSize();
+
+    sf::View view{sf::FloatRect(0.0f, 0.0f, (float)fullSize.x, (float)fullSize.y)};
+    view.setViewport(sf::FloatRect(0.0f, 0.0f, (float)drawnSize.x / fullSize.x, (float)drawnSize.y / fullSize.y));
+    texture.setView(view);
+
+    sprite.setTextureRect(sf::IntRect(0, 0, (int)drawnSize.x, (int)drawnSize.y));
+}
+
+sf::Vector2u ScaledSurface::renderSize() const
+{
+    sf::Vector2u fullSize = texture.getSize();
+    unsigned width = (unsigned)(fullSize.x * renderScale + 0.5f);
+    unsigned height = (unsigned)(fullSize.y * renderScale + 0.5f);
+    return {width > 0 ? width : 1, height > 0 ? height : 1};
+}
+
+void ScaledSurface::present(RenderSurface& output)
+{
+    sf::Vector2u outputSize = output.size();
+    sf::Vector2u drawnSize = renderSize();
+    sprite.setScale((float)outputSize.x / drawnSize.x, (float)outputSize.y / drawnSize.y);
+    output.draw(sprite);
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <SFML/Graphics.hpp>
+
+// Something a frame is drawn to
+// * Every draw goes through draw(), so the surface counts the draw calls of a frame
+// * WindowSurface shows the frames in the game window
+// * OffscreenSurface draws into a texture, so frames can be rendered (and saved) without a window
+// * ScaledSurface draws at a lower resolution and is shown upscaled on another surface
+class RenderSurface
+{
+    public:
+        virtual ~RenderSurface() {}
+
+        virtual sf::RenderTarget& target() = 0;
+        virtual void display() = 0;
+
+        void clear(const sf::Color& color);
+        void draw(const sf::Drawable& drawable, const sf::RenderStates& states = sf::RenderStates::Default);
+        void draw(const sf::Vertex* vertices, std::size_t vertexCount, sf::PrimitiveType type,
+            const sf::RenderStates& states = sf::RenderStates::Default);
+        sf::Vector2u size();
+
+        // Draw calls since the last resetDrawCalls()
+        int drawCalls() const { return drawCallCount; }
+        void resetDrawCalls() { drawCallCount = 0; }
+
+    private:
+        int drawCallCount = 0;
+};
+
+class WindowSurface : public RenderSurface
+{
+    public:
+        WindowSurface(sf::RenderWindow& window);
+
+        sf::RenderTarget& target() override;
+        void display() override;
+
+    private:
+        sf::RenderWindow& window;
+};
+
+// Needs an OpenGL context but no display, a software renderer (like Mesa's llvmpipe) is enough
+class OffscreenSurface : public RenderSurface
+{
+    public:
+        OffscreenSurface(unsigned width, unsigned height);
+
+        sf::RenderTarget& target() override;
+        void display() override;
+
+        // Saves the last displayed frame, the format follows the extension (.png, .bmp, ...)
+        bool saveFrame(const std::string& fileName) const;
+
+    private:
+        sf::RenderTexture texture;
+};
+
+// Draws at scale times its size, present() shows the frame stretched over another surface (dynamic resolution)
+// * Drawing uses the same coordinates at any scale, the view maps them into the top left part of the texture
+// * The texture keeps its full size, so changing the scale never recreates it
+class ScaledSurface : public RenderSurface
+{
+    public:
+        ScaledSurface(unsigned width, unsigned height);
+
+        sf::RenderTarget& target() override;
+        void display() override;
+
+        void setScale(float scale);
+        float scale() const { return renderScale; }
+        // The pixels that are actually drawn
+        sf::Vector2u renderSize() const;
+
+        // Draws the last displayed frame over the whole output surface
+        void present(RenderSurface& output);
+
+    private:
+        sf::RenderTexture texture;
+        sf::Sprite sprite;
+        float renderScale = 1.0f;
+};
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include "renderer.h"
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <string>
+#include "myMathLib.h"
+
+Renderer::Renderer(ResourceManager& resources, Vector2 windowSize) : windowSize((float)windowSize.x, (float)windowSize.y)
+{
+    // * Background Elements //
+    sf::Uint8 grayValue = (sf::Uint8)50.0f;
+    backgroundColor = sf::Color{grayValue, grayValue, grayValue};
+
+    // White lines in the background
+    rectRoadMarking.setSize(sf::Vector2f(roadMarkingWidth, roadMarkingHeight));
+    // Set the origin to middle top of rectangle
+    rectRoadMarking.setOrigin(rectRoadMarking.getSize().x * 0.5f , rectRoadMarking.getSize().y);
+
+
+    // * UI panels //
+    for (const char* fileName : {"panelBlue.png", "panelRed.png"}) { panelTextureList.push_back(resources.load(fileName)); }
+    for (const TextureHandle& texture : panelTextureList) { panelSpriteList.push_back(*texture.sprite()); }
+
+    // * UI hearts //
+    for (const char* fileName : {"heartFull.png", "heartEmpty.png"}) { heartTextureList.push_back(resources.load(fileName)); }
+    for (const TextureHandle& texture : heartTextureList) { heartSpriteList.push_back(*texture.sprite()); }
+
+    // * UI Text //
+    if (!font.loadFromFile("fonts/Super Cartoon.ttf"))
+    {
+        std::cout << "Could not find font file" << std::endl;
+    }
+    text.setFont(font);
+    text.setFillColor(sf::Color::White);
+    text.setOutlineColor(sf::Color::Black);
+    text.setOutlineThickness(5.0f);
+
+    // The score keeps its own text, so the panels changing the shared text don't make it lay out again
+    scoreText = text;
+    scoreText.setCharacterSize(36);
+    scoreText.setPosition(20.0f, 20.0f);
+    shownScore = std::numeric_limits<float>::quiet_NaN();
+
+    // Darkens the frame behind the pause text
+    pauseShade.setSize(this->windowSize);
+    pauseShade.setFillColor(sf::Color{0, 0, 0, 150});
+}
+
+void Renderer::draw(RenderSurface& surface, World& world, FrameArena& frameArena, ParticleSystem* particles)
+{
+    drawScene(surface, world, particles);
+    drawOverlay(surface, world, frameArena);
+}
+
+void Renderer::drawScene(RenderSurface& surface, World& world, ParticleSystem* particles)
+{
+    drawBackground(surface, world);
+
+    // * Draw rigidBody objects //
+    world.draw(surface);
+
+    // * Draw particles //
+    if (particles != nullptr) { particles->draw(surface, world.cameraPosition); }
+}
+
+void Renderer::drawOverlay(RenderSurface& surface, const World& world, FrameArena& frameArena)
+{
+    drawHUD(surface, world, frameArena);
+    if (world.gameOver) { drawGameOver(surface, world, frameArena); }
+}
+
+// The road markings are the lane borders of the world (see WorldSettings::roadMarkingLineAmount)
+void Renderer::drawBackground(RenderSurface& surface, const World& world)
+{
+    surface.clear(backgroundColor);
+
+    const Vector2& cameraPosition = world.cameraPosition;
+    int roadMarkingLineAmount = world.settings.roadMarkingLineAmount;
+
+    // Draw white stripes
+    for (int i = 0; i < roadMarkingLineAmount + 2 ; i++)
+    {
+        float distanceBetweenOrigin = rectRoadMarking.getSize().y + roadMarkingdistance;
+        for (int j = 0; j < windowSize.y / rectRoadMarking.getSize().y * 0.5f; j++)
+        {
+            rectRoadMarking.setPosition(windowSize.x / (roadMarkingLineAmount + 1) * i, 
+                j * distanceBetweenOrigin - ((int)cameraPosition.y % (int)distanceBetweenOrigin));
+            surface.draw(rectRoadMarking);
+        }
+    }
+}
+
+void Renderer::drawHUD(RenderSurface& surface, const World& world, FrameArena& frameArena)
+{
+    const Player& player = *world.bodies.player;
+
+    for (int i = 1; i <= player.maxHealth; i++)
+    {
+        // Full or empty heart, moved in place instead of copied
+        sf::Sprite& sprite = i <= player.health ? heartSpriteList.front() : heartSpriteList.back();
+
+        sprite.setPosition(windowSize.x - i * ((float)sprite.getTexture()->getSize().x + 10.0f) - 15.0f, 20.0f);
+        surface.draw(sprite);
+    }
+
+    // Only formatted when the shown score changes, same format as std::to_string
+    float score = MyMathLib::round(world.score, 2);
+    if (score != shownScore)
+    {
+        const int scoreTextSize = 64;
+        char* buffer = frameArena.allocateArray<char>(scoreTextSize);
+        std::snprintf(buffer, scoreTextSize, "Score: %f", score);
+        scoreText.setString(buffer);
+        shownScore = score;
+    }
+    surface.draw(scoreText);
+}
+
+void Renderer::drawGameOver(RenderSurface& surface, const World& world, FrameArena& frameArena)
+{
+    bool won = world.score >= world.settings.winCondition;
+    sf::Sprite& sprite = won ? panelSpriteList.front() : panelSpriteList.back();
+
+    // Show win or lose screen depending on score
+    const int additionalTextSize = 64;
+    char* additionalText = frameArena.allocateArray<char>(additionalTextSize);
+    text.setString(won ? "You Win!" : "You Lose!");
+    std::snprintf(additionalText, additionalTextSize, won ? "Your score reached past %d" : "Your score didn't reach past %d",
+        (int)world.settings.winCondition);
+
+    // Panel
+    sprite.setOrigin((float)sprite.getTexture()->getSize().x / 2.0f, (float)sprite.getTexture()->getSize().y / 2.0f);
+    sprite.setPosition(windowSize.x / 2, windowSize.y / 2);
+    surface.draw(sprite);
+
+    // Text
+    text.setCharacterSize(72);
+    sf::FloatRect bounds = text.getLocalBounds();
+    text.setPosition((windowSize.x - bounds.width) / 2, windowSize.y / 2 - bounds.height * 1.5f);
+    surface.draw(text);
+
+    text.setString(additionalText);
+    text.setCharacterSize(24);
+    bounds = text.getLocalBounds();
+    text.setPosition((windowSize.x - bounds.width) / 2, windowSize.y / 2 + bounds.height * 1.5f);
+    surface.draw(text);
+
+    text.setString("Press R to play again");
+    bounds = text.getLocalBounds();
+    text.setPosition((windowSize.x - bounds.width) / 2, windowSize.y / 2 + bounds.height * 4.0f);
+    surface.draw(text);
+}
+
+void Renderer::drawPaused(RenderSurface& surface)
+{
+    surface.draw(pauseShade);
+
+    text.setString("Paused");
+    text.setCharacterSize(72);
+    sf::FloatRect bounds = text.getLocalBounds();
+    text.setPosition((windowSize.x - bounds.width) / 2, windowSize.y / 2 - bounds.height * 1.5f);
+    surface.draw(text);
+
+    text.setString("Press Space to continue or R to restart");
+    text.setCharacterSize(24);
+    bounds = text.getLocalBounds();
+    text.setPosition((windowSize.x - bounds.width) / 2, windowSize.y / 2 + bounds.height * 1.5f);
+    surface.draw(text);
+}
\ No newline at end of file
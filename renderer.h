@@ -0,0 +1,56 @@
+#pragma once
+
+#include <list>
+#include <SFML/Graphics.hpp>
+
+#include "vector2.h"
+#include "world.h"
+#include "renderSurface.h"
+#include "resourceManager.h"
+#include "frameArena.h"
+#include "particleSystem.h"
+
+// Draws a frame of a world: the road, the bodies, the particles, the HUD and the game over or pause panel
+// * Only reads the world, so the same world can be drawn to any surface
+// * The scene (road and bodies) and the overlay (HUD and panel) can go to different surfaces,
+//   so the scene can be drawn at a lower resolution while the text stays sharp (see ScaledSurface)
+// * Text for the frame is formatted into the frame arena, which the caller resets every frame,
+//   the score text only when the shown score changes
+class Renderer
+{
+    public:
+        Renderer(ResourceManager& resources, Vector2 windowSize);
+
+        // The particles are drawn over the bodies, nullptr draws none
+        void draw(RenderSurface& surface, World& world, FrameArena& frameArena, ParticleSystem* particles = nullptr);
+        void drawScene(RenderSurface& surface, World& world, ParticleSystem* particles = nullptr);
+        void drawOverlay(RenderSurface& surface, const World& world, FrameArena& frameArena);
+        // Over a drawn frame, while the game is paused
+        void drawPaused(RenderSurface& surface);
+
+    private:
+        sf::Vector2f windowSize;
+
+        // * Road Markings //
+        float roadMarkingWidth = 5.0f;
+        float roadMarkingHeight = 20.0f;
+        float roadMarkingdistance = 40.0f;
+
+        sf::Color backgroundColor;
+        sf::RectangleShape rectRoadMarking;
+
+        // * UI //
+        std::list<TextureHandle> panelTextureList;  // Win, lose
+        std::list<sf::Sprite> panelSpriteList;
+        std::list<TextureHandle> heartTextureList;  // Full, empty
+        std::list<sf::Sprite> heartSpriteList;
+        sf::Font font;
+        sf::Text text;
+        sf::Text scoreText;
+        float shownScore;           // The rounded score in scoreText
+        sf::RectangleShape pauseShade;
+
+        void drawBackground(RenderSurface& surface, const World& world);
+        void drawHUD(RenderSurface& surface, const World& world, FrameArena& frameArena);
+        void drawGameOver(RenderSurface& surface, const World& world, FrameArena& frameArena);
+};
\ No newline at end of file
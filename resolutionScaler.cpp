@@ -0,0 +1,39 @@
+#include "resolutionScaler.h"
+
+#include "myMathLib.h"
+
+ResolutionScaler::ResolutionScaler(float budgetMs, float minScale, float maxScale) :
+    budgetMs(budgetMs), minScale(minScale), maxScale(maxScale), current(maxScale), average(budgetMs * headroom) {}
+
+void ResolutionScaler::frameFinished(float frameMs)
+{
+    average += (frameMs - average) * smoothing;
+    frames++;
+    scaleSum += current;
+
+    if (++framesSinceChange < settleFrames) { return; }
+
+    if (average > budgetMs)
+    {
+        // Rendering cost grows with the pixel count, the scale with its square root
+        setScale(MyMathLib::floor(current * MyMathLib::sqrt(budgetMs / average) * 20.0f) / 20.0f);
+    }
+    else
+    {
+        // Raise when the next step up is expected to still fit, guessed as if the whole frame scaled with the pixels
+        float next = current + 0.05f;
+        if (average * (next * next) / (current * current) < budgetMs * headroom) { setScale(next); }
+    }
+}
+
+void ResolutionScaler::setScale(float scale)
+{
+    scale = MyMathLib::clamp(scale, minScale, maxScale);
+    if (MyMathLib::abs(scale - current) < 0.001f) { return; }
+
+    current = scale;
+    framesSinceChange = 0;
+    changeCount++;
+}
+
+float ResolutionScaler::averageScale() const { return frames > 0 ? (float)(scaleSum / frames) : current; }
\ No newline at end of file
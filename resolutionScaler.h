@@ -0,0 +1,45 @@
+#pragma once
+
+// Picks the scale the scene is rendered at, so frames stay within a time budget (dynamic resolution)
+// * Feed it how long every frame took to draw and display, without the simulation before it
+//   or the time spent waiting for the next frame
+//   (a display() that waits for vsync counts as waiting, so there is nothing to feed it with vsync)
+// * Drops the scale right away when frames overrun (the cost follows the pixel count, so by the square root of
+//   the overrun), and raises it a step at a time while the next step is expected to fit
+// * The scale moves in steps of 0.05, so it doesn't shimmer between nearly equal sizes
+class ResolutionScaler
+{
+    public:
+        ResolutionScaler(float budgetMs, float minScale = 0.5f, float maxScale = 1.0f);
+
+        void frameFinished(float frameMs);
+
+        float scale() const { return current; }
+        float averageFrameMs() const { return average; }
+
+        // Over every frame so far
+        int changes() const { return changeCount; }
+        float averageScale() const;
+
+    private:
+        float budgetMs;
+        float minScale;
+        float maxScale;
+        float current;
+
+        // Exponential moving average, a single slow frame (loading, a hiccup of the OS) doesn't change the scale
+        float average = 0.0f;
+        static constexpr float smoothing = 0.1f;
+
+        // Frames to wait after a change before judging again, the average needs time to catch up
+        static constexpr int settleFrames = 20;
+        int framesSinceChange = 0;
+        // Raising only happens when the next scale is expected to stay below this part of the budget
+        static constexpr float headroom = 0.9f;
+
+        int changeCount = 0;
+        int frames = 0;
+        double scaleSum = 0.0;
+
+        void setScale(float scale);
+};
\ No newline at end of file
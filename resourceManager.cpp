@@ -0,0 +1,76 @@
+#include "resourceManager.h"
+#include <iostream>
+
+// * TextureHandle //
+TextureHandle::TextureHandle(ResourceManager* manager, TextureEntry* entry) : manager(manager), entry(entry)
+{
+    entry->refCount++;
+}
+
+TextureHandle::~TextureHandle()
+{
+    if (entry != nullptr) { manager->release(entry); }
+}
+
+TextureHandle::TextureHandle(const TextureHandle& other) : manager(other.manager), entry(other.entry)
+{
+    if (entry != nullptr) { entry->refCount++; }
+}
+
+TextureHandle::TextureHandle(TextureHandle&& other) noexcept : manager(other.manager), entry(other.entry)
+{
+    other.manager = nullptr;
+    other.entry = nullptr;
+}
+
+// Copy and swap, the old texture is released when other goes out of scope
+TextureHandle& TextureHandle::operator=(TextureHandle other) noexcept
+{
+    std::swap(manager, other.manager);
+    std::swap(entry, other.entry);
+    return *this;
+}
+
+
+// * ResourceManager //
+ResourceManager::ResourceManager(std::string directory) : directory(directory) {}
+
+TextureHandle ResourceManager::load(const std::string& fileName)
+{
+    auto found = textures.find(fileName);
+    if (found != textures.end()) { return TextureHandle{this, &found->second}; }
+
+    TextureEntry& entry = textures[fileName];
+    entry.name = fileName;
+
+    // Load through an image, so the collision mask can be built from the pixels before they only live on the GPU
+    sf::Image image;
+    if (!image.loadFromFile(directory + fileName)) { std::cout << "Could not load image" << std::endl; }
+    else
+    {
+        entry.texture.loadFromImage(image);
+        entry.mask = PixelMask{image};
+    }
+    entry.sprite.setTexture(entry.texture, true);
+    return TextureHandle{this, &entry};
+}
+
+void ResourceManager::release(TextureEntry* entry)
+{
+    if (--entry->refCount == 0) { textures.erase(entry->name); }
+}
+
+ResourceManager::MemoryUsage ResourceManager::memoryUsage() const
+{
+    MemoryUsage usage;
+    for (const auto& pair : textures)
+    {
+        const TextureEntry& entry = pair.second;
+        sf::Vector2u size = entry.texture.getSize();
+        usage.textureCount++;
+        usage.gpuBytes += (std::size_t)size.x * size.y * 4;
+        usage.maskBytes += entry.mask.memoryUsage();
+        usage.entryBytes += sizeof(TextureEntry) + entry.name.capacity() + pair.first.capacity();
+    }
+    return usage;
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <SFML/Graphics.hpp>
+#include "pixelMask.h"
+
+// A loaded texture, the sprite every body of that texture draws with and its collision mask
+struct TextureEntry
+{
+    std::string name;
+    sf::Texture texture;
+    sf::Sprite sprite;      // Shared template, bodies draw it with their own transform and never change it
+    PixelMask mask;         // Opaque pixels of the texture, for pixel accurate collisions
+    int refCount = 0;
+};
+
+class ResourceManager;
+
+// Lightweight reference to a texture of a ResourceManager
+// * Copying a handle only bumps the reference count, the texture is freed when the last handle goes away
+// * An empty handle (headless) has no texture and no sprite
+class TextureHandle
+{
+    public:
+        TextureHandle() = default;
+        ~TextureHandle();
+        TextureHandle(const TextureHandle& other);
+        TextureHandle(TextureHandle&& other) noexcept;
+        TextureHandle& operator=(TextureHandle other) noexcept;
+
+        bool valid() const { return entry != nullptr; }
+        const sf::Texture* texture() const { return entry != nullptr ? &entry->texture : nullptr; }
+        const sf::Sprite* sprite() const { return entry != nullptr ? &entry->sprite : nullptr; }
+        const PixelMask* mask() const { return entry != nullptr && !entry->mask.empty() ? &entry->mask : nullptr; }
+        int width() const { return entry != nullptr ? (int)entry->texture.getSize().x : 0; }
+        int height() const { return entry != nullptr ? (int)entry->texture.getSize().y : 0; }
+
+    private:
+        friend class ResourceManager;
+        TextureHandle(ResourceManager* manager, TextureEntry* entry);
+
+        ResourceManager* manager = nullptr;
+        TextureEntry* entry = nullptr;
+};
+
+// Loads every texture once, no matter how many car types or UI elements use it
+// * Textures are looked up by file name (relative to the textures folder)
+// * The manager has to outlive all of its handles
+class ResourceManager
+{
+    public:
+        struct MemoryUsage
+        {
+            int textureCount = 0;
+            std::size_t gpuBytes = 0;       // RGBA pixels uploaded to the GPU
+            std::size_t maskBytes = 0;      // Collision masks, the only pixel data kept on the CPU (the images are dropped after loading)
+            std::size_t entryBytes = 0;     // The texture entries (texture and sprite objects) and their names
+        };
+
+        ResourceManager(std::string directory = "textures/");
+        ResourceManager(const ResourceManager& other) = delete;
+        ResourceManager& operator=(const ResourceManager& other) = delete;
+
+        TextureHandle load(const std::string& fileName);
+        MemoryUsage memoryUsage() const;
+
+    private:
+        friend class TextureHandle;
+
+        std::string directory;
+        std::unordered_map<std::string, TextureEntry> textures;   // Nodes don't move, so handles can point into them
+
+        void release(TextureEntry* entry);
+};
\ No newline at end of file
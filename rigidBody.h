@@ -1,7 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include "body.h"
 #include "myMathLib.h"
+#include "integrators.h"
+#include "renderSurface.h"
+#include "pixelMask.h"
 #include <SFML/Graphics.hpp>
 
 // Force            -   v += f * dt / m     -   time and mass
@@ -11,45 +15,226 @@
 
 enum class ForceMode { FORCE, ACCELERATION, IMPULSE, VELOCITYCHANGE };
 enum class Faction { PLAYER, CAR };
+constexpr int factionCount = 2;
+
+// Every faction has its own collision layer bit
+inline std::uint32_t collisionLayerOf(Faction faction) { return 1u << (int)faction; }
+
+// Plain data copy of the simulation state of a rigidbody (see WorldSnapshot)
+struct BodyState
+{
+    int id;
+    Faction faction;
+    int width;
+    int height;
+    Vector2 pos;
+    Vector2 vel;
+    Vector2 accel;
+    Scalar forceAmountPerFrame;
+    bool intangible;
+
+    // Player
+    int health;
+    bool hit;
+    std::uint64_t intangibleUntil;  // The tick of the world's timers the intangibility ends at
+
+    // Car
+    int typeIndex;
+    bool alive;
+    bool horizontalDir;
+    float horizontalMultiplier;
+    int lastHitID;
+};
+
+// * Static dispatch //
+// Stepping is a template on the type of the body (Self) and on the container of the other bodies (Bodies)
+// * Self = Car or Player (final classes): the window and collision handlers are called directly and can be inlined
+// * Self = RigidBody with a BodyList: every handler call is virtual
+// * Bodies needs forEach(f), which calls f with every body (see BodyList and BodyGroups)
 
 class RigidBody : public Body
 {
     public:
-        RigidBody(int id, int width, int height, float maxVel, float forceAmountPerFrame,
-            float frictionCoefficient, float mass, Faction faction);
+        RigidBody(int id, int width, int height, float forceAmountPerFrame, Faction faction);
         virtual ~RigidBody();
         RigidBody(const RigidBody& other);
 
         int id;
-        Vector2* vel;
-        float mass;
+        Vector2 vel;
         bool intangible = false;
         Faction faction;
-        sf::Sprite* sprite;
+        std::uint32_t collisionLayer;   // The layer bit of the body
+        std::uint32_t collisionMask;    // The layers this body reacts to (see CollisionMatrix)
+        const sf::Sprite* sprite = nullptr;    // Shared per body type (see ResourceManager), nullptr when headless
+        const PixelMask* pixelMask = nullptr;  // Shared per body type, nullptr collides as a box
+
+        static constexpr float gravity = 9.80665f;
+        // Friction was tuned at this framerate, it builds up by the same amount per second at any other
+        static constexpr float referenceFrameRate = 60.0f;
+        // The timers of the world (see World::timers) count this many ticks per second
+        static constexpr float tickRate = 1000.0f;
+
+        // How the position is integrated, body types pick their own (see integrators.h)
+        using Integrator = AnalyticFriction;
+
+        // The motion of a body during a step in any scalar type, RigidBody uses Scalar (see fixed.h)
+        template <class Integrator, class T>
+        static void integrateMotion(const Vector2T<T>& pos, const Vector2T<T>& vel, Vector2T<T>& accel, T maxVel,
+            T frictionCoefficient, T deltaTime, Vector2T<T>& newVel, Vector2T<T>& newPos);
+
+        // Steps the body with virtual calls to all of its handlers
+        virtual bool update(std::list<RigidBody*>& rbList, Vector2& windowSize, Vector2& camPos, float deltaTime) = 0;
+        // Constants of the body's type: the player keeps its own, a car reads its archetype (see carArchetypes.h)
+        // * Stepping calls them on the concrete type, so with final classes they are direct calls (or constants)
+        virtual Scalar maxVelocity() const = 0;
+        virtual Scalar friction() const = 0;
+        virtual Scalar bodyMass() const = 0;
+        virtual void draw(RenderSurface& surface, Vector2& camPos);
+        void addForce(const Vector2& force, ForceMode fMode, float deltaTime);
 
-        virtual bool update(std::list<RigidBody*>& rbList, Vector2& windowSize, sf::RenderWindow& window, Vector2& camPos, float deltaTime) = 0;
-        void loadSprite(sf::Texture& texture);
-        void addForce(Vector2& force, ForceMode fMode, float deltaTime);
+        virtual void saveState(BodyState& state) const;
+        virtual void loadState(const BodyState& state);
 
     protected:
-        Vector2* accel;
-        float maxVel;
-        float forceAmountPerFrame;
-        float frictionCoefficient; // Between 0.0f and 1.0f
+        Vector2 accel;
+        Scalar forceAmountPerFrame;
 
-        void updateNextPos(std::list<RigidBody*>& rbList, Vector2& windowSize, Vector2& camPos, float deltaTime);
+        template <class Self>
+        void integrate(Vector2& newVel, Vector2& newPos, float deltaTime);
+        template <class Self, class Bodies>
+        void updateNextPos(Bodies& bodies, Vector2& windowSize, Vector2& camPos, float deltaTime);
 
         bool verticalCollisionDetection(const RigidBody& other, Vector2& nextPos) const;
         bool horizontalCollisionDetection(const RigidBody& other, Vector2& nextPos) const;
         bool objectCollisionDetection(const RigidBody& other, Vector2& nextPos) const;
+        bool pixelCollisionDetection(const RigidBody& other, Vector2& nextPos) const;
+        bool reactsTo(const RigidBody& other) const;
+        bool canCollide(const RigidBody& other) const;
         virtual bool onObjectCollision(RigidBody& other);
         
-        bool topWindowDetection(Vector2& nextPos, float windowTopPos) const;
-        bool bottomWindowDetection(Vector2& nextPos, float windowBottomPos) const;
-        bool leftWindowDetection(Vector2& nextPos, float windowLeftPos) const;
-        bool rightWindowDetection(Vector2& nextPos, float windowRightPos) const;
+        bool topWindowDetection(Vector2& nextPos, Scalar windowTopPos) const;
+        bool bottomWindowDetection(Vector2& nextPos, Scalar windowBottomPos) const;
+        bool leftWindowDetection(Vector2& nextPos, Scalar windowLeftPos) const;
+        bool rightWindowDetection(Vector2& nextPos, Scalar windowRightPos) const;
         
+        template <class Self>
         void windowDetection(Vector2& currentVel, Vector2& nextPos, Vector2& windowSize, Vector2& camPos);
-        virtual void onVerticalWindowHit(Vector2& currentVel, Vector2& nextPos, float windowPos, float camVerticalPos);
-        virtual void onHorizontalWindowHit(Vector2& currentVel, Vector2& nextPos, float windowPos, float camHorizontalPos);
-};
\ No newline at end of file
+        virtual void onVerticalWindowHit(Vector2& currentVel, Vector2& nextPos, Scalar windowPos, Scalar camVerticalPos);
+        virtual void onHorizontalWindowHit(Vector2& currentVel, Vector2& nextPos, Scalar windowPos, Scalar camHorizontalPos);
+};
+
+// Whether this body's onObjectCollision should be called when touching the other body
+inline bool RigidBody::reactsTo(const RigidBody& other) const { return (collisionMask & other.collisionLayer) != 0; }
+
+// Intangible bodies don't collide at all
+inline bool RigidBody::canCollide(const RigidBody& other) const
+{
+    return !intangible && !other.intangible && (reactsTo(other) || other.reactsTo(*this));
+}
+
+// All bodies behind base pointers, so every handler call is virtual
+struct BodyList
+{
+    std::list<RigidBody*>& rbList;
+
+    template <class F>
+    void forEach(F&& f) { for (RigidBody* rbObject : rbList) { f(*rbObject); } }
+};
+
+template <class Self, class Bodies>
+void RigidBody::updateNextPos(Bodies& bodies, Vector2& windowSize, Vector2& camPos, float deltaTime)
+{
+    Self& self = static_cast<Self&>(*this);
+
+    Vector2 newVel;
+    Vector2 newPos;
+    integrate<Self>(newVel, newPos, deltaTime);
+
+    // Check object collision
+    bool stopMovement = false;
+
+    bodies.forEach([&](auto& rbObject)
+    {
+        // Skip self
+        if (&rbObject == this) { return; }
+
+        // Skip pairs where neither body reacts to the other
+        if (!canCollide(rbObject)) { return; }
+
+        // Boxes first, the pixels only when the boxes overlap
+        if (objectCollisionDetection(rbObject, newPos) && pixelCollisionDetection(rbObject, newPos))
+        {
+            if (rbObject.reactsTo(*this)) { rbObject.onObjectCollision(*this); }
+            bool stopping = reactsTo(rbObject) && self.onObjectCollision(rbObject);
+
+            stopMovement = stopMovement || stopping;
+        }
+    });
+
+    // Check window detection
+    windowDetection<Self>(newVel, newPos, windowSize, camPos);
+
+    if (!stopMovement) { vel = newVel; pos = newPos; }
+    else { vel = Vector2{}; }
+}
+
+// The axis stops at 0 instead of changing direction, and has its acceleration reset
+// * moveTime becomes the moment within the step where it stopped
+template <class T>
+inline T stopAtZero(T velocity, T deltaVelocity, T& acceleration, T& moveTime)
+{
+    if ((velocity > 0.0f && -velocity >= deltaVelocity) ||
+        (velocity < 0.0f && -velocity <= deltaVelocity))
+    {
+        moveTime *= velocity / -deltaVelocity;
+        acceleration = T(0.0f);
+        return T(0.0f);
+    }
+    return velocity + deltaVelocity;
+}
+
+// Calculates the velocity and position after deltaTime, without looking at other bodies
+template <class Self>
+void RigidBody::integrate(Vector2& newVel, Vector2& newPos, float deltaTime)
+{
+    const Self& self = static_cast<const Self&>(*this);
+    integrateMotion<typename Self::Integrator, Scalar>(pos, vel, accel, self.maxVelocity(), self.friction(), Scalar{deltaTime}, newVel, newPos);
+}
+
+template <class Integrator, class T>
+void RigidBody::integrateMotion(const Vector2T<T>& pos, const Vector2T<T>& vel, Vector2T<T>& accel, T maxVel,
+    T frictionCoefficient, T deltaTime, Vector2T<T>& newVel, Vector2T<T>& newPos)
+{
+    // If moving, friction builds up in the acceleration, opposite to the velocity
+    T sqrSpeed = vel.sqrMagnitude();
+    T speed = sqrSpeed > 0.0f ? MyMathLib::sqrt(sqrSpeed) : T{0.0f};
+    if (speed > 0.0f)
+    {
+        accel -= vel * (gravity * frictionCoefficient * deltaTime * referenceFrameRate / speed);
+    }
+
+    // Get the delta velocity
+    Vector2T<T> deltaVel = accel * deltaTime;
+    Vector2T<T> moveTime{deltaTime, deltaTime};
+
+    // If x or y reach 0, let it stay 0 and reset acceleration
+    newVel.x = stopAtZero(vel.x, deltaVel.x, accel.x, moveTime.x);
+    newVel.y = stopAtZero(vel.y, deltaVel.y, accel.y, moveTime.y);
+
+    // Only needs a square root when actually going too fast
+    T sqrNewSpeed = newVel.sqrMagnitude();
+    if (sqrNewSpeed > maxVel * maxVel) { newVel *= maxVel / MyMathLib::sqrt(sqrNewSpeed); }
+
+    newPos = Integrator::position(pos, vel, newVel, moveTime, deltaTime);
+}
+
+template <class Self>
+void RigidBody::windowDetection(Vector2& currentVel, Vector2& nextPos, Vector2& windowSize, Vector2& camPos)
+{
+    Self& self = static_cast<Self&>(*this);
+
+    if (topWindowDetection(nextPos, 0.0f + camPos.y)) { self.onVerticalWindowHit(currentVel, nextPos, Scalar{0.0f}, camPos.y); }
+    else if (bottomWindowDetection(nextPos, windowSize.y + camPos.y)) { self.onVerticalWindowHit(currentVel, nextPos, windowSize.y, camPos.y); }
+    if (leftWindowDetection(nextPos, 0.0f + camPos.x)) { self.onHorizontalWindowHit(currentVel, nextPos, Scalar{0.0f}, camPos.x); }
+    else if (rightWindowDetection(nextPos, windowSize.x + camPos.x)) { self.onHorizontalWindowHit(currentVel, nextPos, windowSize.x, camPos.x); }
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "scheduler.h"
+
+#include <algorithm>
+
+Scheduler::Scheduler(float tickRate) : tickRate(tickRate) {}
+
+Scheduler::~Scheduler() { stopAll(); }
+
+void Scheduler::start(Behaviour behaviour)
+{
+    Behaviour::Handle handle = behaviour.handle;
+    behaviour.handle = nullptr;
+
+    handle.promise().scheduler = this;
+    behaviours.push_back(handle);
+    resume(handle);
+}
+
+void Scheduler::stopAll()
+{
+    for (Behaviour::Handle handle : behaviours)
+    {
+        wheel.cancel(handle.promise().timer);
+        handle.destroy();
+    }
+    behaviours.clear();
+}
+
+void Scheduler::advance(float deltaTime)
+{
+    pendingTicks += (double)deltaTime * tickRate;
+    std::uint64_t ticks = (std::uint64_t)pendingTicks;
+    pendingTicks -= (double)ticks;
+    wheel.advance(ticks);
+}
+
+Scheduler::WaitAwaiter Scheduler::wait(float seconds)
+{
+    return WaitAwaiter{*this, ticksFor(seconds, tickRate)};
+}
+
+void Scheduler::WaitAwaiter::await_suspend(Behaviour::Handle handle)
+{
+    handle.promise().timer = scheduler.wheel.schedule(ticks, &Scheduler::onTimer, handle.address());
+}
+
+// The timer callback, the context is the address of the waiting coroutine
+void Scheduler::onTimer(void* context)
+{
+    Behaviour::Handle handle = Behaviour::Handle::from_address(context);
+    handle.promise().scheduler->resume(handle);
+}
+
+void Scheduler::resume(Behaviour::Handle handle)
+{
+    handle.resume();
+    if (!handle.done()) { return; }
+
+    behaviours.erase(std::find(behaviours.begin(), behaviours.end(), handle));
+    handle.destroy();
+}
\ No newline at end of file
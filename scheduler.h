@@ -0,0 +1,83 @@
+#pragma once
+
+#include <coroutine>
+#include <cstdint>
+#include <vector>
+
+#include "timerWheel.h"
+
+class Scheduler;
+
+// * Behaviours //
+// A coroutine that runs on a Scheduler, it sleeps with co_await scheduler.wait(seconds)
+//     Behaviour Autopilot::planning() { while (true) { plan(); co_await scheduler.wait(interval); } }
+// * A sleeping behaviour is a timer in the wheel, it isn't resumed (or looked at) until the timer fires
+// * The behaviour starts when it is handed to Scheduler::start(), and ends with the scheduler
+class Behaviour
+{
+    public:
+        struct promise_type
+        {
+            Scheduler* scheduler = nullptr;
+            TimerWheel::TimerId timer;
+
+            Behaviour get_return_object() { return Behaviour{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            // Suspended at the end, so the scheduler can destroy it after resuming it
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { throw; }
+        };
+
+        using Handle = std::coroutine_handle<promise_type>;
+
+        Behaviour(Behaviour&& other) noexcept : handle(other.handle) { other.handle = nullptr; }
+        Behaviour& operator=(Behaviour&& other) = delete;
+        Behaviour(const Behaviour& other) = delete;
+        ~Behaviour() { if (handle) { handle.destroy(); } }
+
+    private:
+        friend class Scheduler;
+        explicit Behaviour(Handle handle) : handle(handle) {}
+        Handle handle;
+};
+
+// Runs behaviours on a timer wheel, time only moves when advance() is called
+// * Time is counted in ticks (tickRate per second), waits are rounded to the nearest tick
+class Scheduler
+{
+    public:
+        Scheduler(float tickRate = 1000.0f);
+        ~Scheduler();
+        Scheduler(const Scheduler& other) = delete;
+        Scheduler& operator=(const Scheduler& other) = delete;
+
+        // Runs the behaviour until its first wait
+        void start(Behaviour behaviour);
+        // Destroys every behaviour, waiting or not
+        void stopAll();
+
+        void advance(float deltaTime);
+
+        struct WaitAwaiter
+        {
+            Scheduler& scheduler;
+            std::uint64_t ticks;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(Behaviour::Handle handle);
+            void await_resume() const noexcept {}
+        };
+        WaitAwaiter wait(float seconds);
+
+        int running() const { return (int)behaviours.size(); }
+
+    private:
+        TimerWheel wheel;
+        float tickRate;
+        double pendingTicks = 0.0;     // Time that doesn't make up a whole tick yet
+        std::vector<Behaviour::Handle> behaviours;
+
+        static void onTimer(void* context);
+        void resume(Behaviour::Handle handle);
+};
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// Lock-free queue for exactly one producer thread and one consumer thread
+// * Fixed capacity (a power of 2), push() fails when it is full instead of allocating
+template <class T, std::size_t Capacity>
+class SpscQueue
+{
+    static_assert((Capacity & (Capacity - 1)) == 0, "SpscQueue capacity has to be a power of 2");
+
+    public:
+        // Producer
+        bool push(const T& value)
+        {
+            std::size_t tail = tailIndex.load(std::memory_order_relaxed);
+            if (tail - headIndex.load(std::memory_order_acquire) == Capacity) { return false; }
+
+            items[tail & (Capacity - 1)] = value;
+            tailIndex.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer, returns nullptr when empty
+        const T* front() const
+        {
+            std::size_t head = headIndex.load(std::memory_order_relaxed);
+            if (head == tailIndex.load(std::memory_order_acquire)) { return nullptr; }
+            return &items[head & (Capacity - 1)];
+        }
+
+        // Consumer
+        void pop() { headIndex.store(headIndex.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    private:
+        T items[Capacity];
+        // On their own cache lines, so the two threads don't fight over them
+        alignas(64) std::atomic<std::size_t> headIndex{0};
+        alignas(64) std::atomic<std::size_t> tailIndex{0};
+};
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "threadPool.h"
+
+ThreadPool::ThreadPool(int threadCount)
+{
+    if (threadCount < 0) { threadCount = (int)std::thread::hardware_concurrency(); }
+
+    // The calling thread counts as one of the threads
+    for (int i = 1; i < threadCount; i++) { workers.emplace_back(&ThreadPool::workerLoop, this); }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    for (std::thread& worker : workers) { worker.join(); }
+}
+
+int ThreadPool::threadCount() const { return (int)workers.size() + 1; }
+
+void ThreadPool::parallelFor(int count, JobRef job, int chunkSize)
+{
+    if (count <= 0) { return; }
+
+    // Not worth waking the workers
+    if (workers.empty() || count <= chunkSize) { job(0, count); return; }
+
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        currentJob = &job;
+        jobCount = count;
+        jobChunkSize = chunkSize;
+        nextIndex = 0;
+        busyWorkers = (int)workers.size();
+        generation++;
+    }
+    wakeCondition.notify_all();
+
+    runChunks();
+
+    std::unique_lock<std::mutex> lock{mutex};
+    doneCondition.wait(lock, [this] { return busyWorkers == 0; });
+    currentJob = nullptr;
+}
+
+void ThreadPool::runChunks()
+{
+    while (true)
+    {
+        int begin = nextIndex.fetch_add(jobChunkSize);
+        if (begin >= jobCount) { return; }
+
+        int end = begin + jobChunkSize < jobCount ? begin + jobChunkSize : jobCount;
+        (*currentJob)(begin, end);
+    }
+}
+
+void ThreadPool::workerLoop()
+{
+    unsigned seenGeneration = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            wakeCondition.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) { return; }
+            seenGeneration = generation;
+        }
+
+        runChunks();
+
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            busyWorkers--;
+        }
+        doneCondition.notify_one();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Non-owning reference to a job(begin, end) callable
+// * Unlike std::function it never copies the callable, so a lambda with many captures doesn't allocate
+// ! The callable has to outlive the reference, fine for parallelFor which returns once the job is done
+class JobRef
+{
+    public:
+        template <class Job>
+        JobRef(const Job& job) : job(&job), invoke([](const void* job, int begin, int end) { (*static_cast<const Job*>(job))(begin, end); }) {}
+
+        void operator()(int begin, int end) const { invoke(job, begin, end); }
+
+    private:
+        const void* job;
+        void (*invoke)(const void* job, int begin, int end);
+};
+
+// Fixed set of worker threads that split a range of indices between them
+// * The calling thread helps out, so a pool with 0 workers simply runs the job inline
+class ThreadPool
+{
+    public:
+        ThreadPool(int threadCount = -1);   // -1 = one thread per core
+        ~ThreadPool();
+        ThreadPool(const ThreadPool& other) = delete;
+        ThreadPool& operator=(const ThreadPool& other) = delete;
+
+        int threadCount() const;
+
+        // Calls job(begin, end) on chunks of [0, count) and returns when every chunk is done
+        void parallelFor(int count, JobRef job, int chunkSize = 1);
+
+    private:
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable wakeCondition;
+        std::condition_variable doneCondition;
+
+        const JobRef* currentJob = nullptr;
+        int jobCount = 0;
+        int jobChunkSize = 1;
+        std::atomic<int> nextIndex{0};
+        int busyWorkers = 0;
+        unsigned generation = 0;
+        bool stopping = false;
+
+        void workerLoop();
+        void runChunks();
+};
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "timerWheel.h"
+
+TimerWheel::TimerWheel(int capacity)
+{
+    for (int& slot : slots) { slot = -1; }
+
+    nodes.resize(capacity > 0 ? capacity : 1);
+    for (int i = (int)nodes.size() - 1; i >= 0; i--) { release(i); }
+}
+
+TimerWheel::TimerId TimerWheel::schedule(std::uint64_t delayTicks, Callback callback, void* context)
+{
+    if (freeNodes < 0)
+    {
+        int oldSize = (int)nodes.size();
+        nodes.resize(oldSize * 2);
+        for (int i = (int)nodes.size() - 1; i >= oldSize; i--) { release(i); }
+    }
+
+    int index = freeNodes;
+    Node& node = nodes[index];
+    freeNodes = node.next;
+
+    node.deadline = current + (delayTicks > 0 ? delayTicks : 1);
+    node.callback = callback;
+    node.context = context;
+    link(index);
+    pendingCount++;
+
+    return TimerId{(std::uint32_t)index, node.generation};
+}
+
+bool TimerWheel::cancel(TimerId id)
+{
+    if (id.index >= nodes.size()) { return false; }
+
+    Node& node = nodes[id.index];
+    if (node.generation != id.generation || node.slot < 0) { return false; }
+
+    unlink(id.index);
+    release(id.index);
+    pendingCount--;
+    return true;
+}
+
+void TimerWheel::clear(std::uint64_t now)
+{
+    for (int index = 0; index < (int)nodes.size(); index++)
+    {
+        if (nodes[index].slot < 0) { continue; }
+        unlink(index);
+        release(index);
+    }
+    pendingCount = 0;
+    current = now;
+}
+
+void TimerWheel::advance(std::uint64_t ticks)
+{
+    for (std::uint64_t i = 0; i < ticks; i++)
+    {
+        current++;
+
+        // Every time a level turns around, the next slot of the level above is spread over the levels below
+        for (int level = 1; level < levelCount; level++)
+        {
+            if ((current & (((std::uint64_t)1 << (slotBits * level)) - 1)) != 0) { break; }
+            cascade(level);
+        }
+
+        // Callbacks can schedule into this very slot (a delay of 0 is the next tick, so not this one)
+        int& slot = slots[current & (slotCount - 1)];
+        while (slot >= 0)
+        {
+            int index = slot;
+            Node& node = nodes[index];
+            Callback callback = node.callback;
+            void* context = node.context;
+
+            unlink(index);
+            release(index);
+            pendingCount--;
+            callback(context);
+        }
+    }
+}
+
+// Puts the timer in the lowest level that reaches its deadline
+void TimerWheel::link(int index)
+{
+    Node& node = nodes[index];
+    std::uint64_t delta = node.deadline - current;
+
+    int level = 0;
+    while (level < levelCount - 1 && delta >= ((std::uint64_t)1 << (slotBits * (level + 1)))) { level++; }
+
+    // Further away than the wheel reaches: park it in the furthest slot, it gets placed again when that cascades
+    std::uint64_t target = node.deadline;
+    if (delta >= ((std::uint64_t)1 << (slotBits * levelCount))) { target = current + ((std::uint64_t)1 << (slotBits * levelCount)) - 1; }
+
+    node.slot = level * slotCount + (int)((target >> (slotBits * level)) & (slotCount - 1));
+    node.previous = -1;
+    node.next = slots[node.slot];
+    if (node.next >= 0) { nodes[node.next].previous = index; }
+    slots[node.slot] = index;
+}
+
+void TimerWheel::unlink(int index)
+{
+    Node& node = nodes[index];
+    if (node.previous >= 0) { nodes[node.previous].next = node.next; }
+    else { slots[node.slot] = node.next; }
+    if (node.next >= 0) { nodes[node.next].previous = node.previous; }
+    node.slot = -1;
+}
+
+void TimerWheel::cascade(int level)
+{
+    int& slot = slots[level * slotCount + (int)((current >> (slotBits * level)) & (slotCount - 1))];
+    int index = slot;
+    slot = -1;
+
+    while (index >= 0)
+    {
+        int next = nodes[index].next;
+        link(index);
+        index = next;
+    }
+}
+
+// Back to the free list, a new generation makes the old TimerIds invalid
+void TimerWheel::release(int index)
+{
+    Node& node = nodes[index];
+    node.generation++;
+    node.slot = -1;
+    node.next = freeNodes;
+    freeNodes = index;
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// * Hierarchical timer wheel //
+// Timers that fire after a number of ticks, scheduling and cancelling are O(1) and a tick only looks at one slot
+// * 4 levels of 64 slots: level 0 holds the next 64 ticks, every level above covers 64 times as long,
+//   a timer moves down a level (cascades) when the wheel below it has turned around
+// * Nothing is polled, so thousands of sleeping timers cost nothing until they are due
+// * The timers live in a pool that only grows when more are pending than ever before
+// ! Callbacks run inside advance(), they may schedule and cancel timers
+class TimerWheel
+{
+    public:
+        using Callback = void (*)(void* context);
+
+        // Stays valid after the timer fired or was cancelled, cancelling it then does nothing
+        struct TimerId
+        {
+            std::uint32_t index = ~0u;
+            std::uint32_t generation = 0;
+        };
+
+        TimerWheel(int capacity = 64);
+
+        // A delay of 0 fires on the next tick
+        TimerId schedule(std::uint64_t delayTicks, Callback callback, void* context);
+        bool cancel(TimerId id);
+
+        // Fires the timers that are due, in order of their deadline
+        void advance(std::uint64_t ticks);
+
+        // Cancels every timer and moves the time to now, for starting over or going back to a saved time
+        void clear(std::uint64_t now);
+
+        std::uint64_t now() const { return current; }
+        int pending() const { return pendingCount; }
+
+    private:
+        static constexpr int slotBits = 6;
+        static constexpr int slotCount = 1 << slotBits;
+        static constexpr int levelCount = 4;
+
+        struct Node
+        {
+            std::uint64_t deadline;
+            Callback callback;
+            void* context;
+            std::uint32_t generation = 0;
+            int slot = -1;      // -1 when free
+            int previous = -1;
+            int next = -1;
+        };
+
+        std::vector<Node> nodes;
+        int freeNodes = -1;     // Free nodes are linked through next
+        int slots[levelCount * slotCount];
+        std::uint64_t current = 0;
+        int pendingCount = 0;
+
+        void link(int index);
+        void unlink(int index);
+        void cascade(int level);
+        void release(int index);
+};
+
+// The amount of ticks closest to seconds, at tickRate ticks per second
+inline std::uint64_t ticksFor(float seconds, float tickRate)
+{
+    double ticks = (double)seconds * tickRate + 0.5;
+    return ticks > 0.0 ? (std::uint64_t)ticks : 0;
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "vecEnv.h"
+
+VecEnv::VecEnv(int envCount, const WorldSettings& settings, Vector2 windowSize, float deltaTime, int maxEpisodeSteps, int threadCount) :
+    seeds(envCount, 0), episodeSteps(envCount, 0), threadPool(threadCount), deltaTime(deltaTime), maxEpisodeSteps(maxEpisodeSteps)
+{
+    for (int i = 0; i < envCount; i++)
+    {
+        worlds.push_back(new World{headlessWorld(settings, windowSize)});
+        worlds.back()->reserveCars(settings.carsMaxAmountToWin());
+    }
+}
+
+VecEnv::~VecEnv() { for (World* world : worlds) { delete world; } }
+
+int VecEnv::envCount() const { return (int)worlds.size(); }
+
+World& VecEnv::world(int index) { return *worlds[index]; }
+
+void VecEnv::reset(const std::uint64_t* seeds, float* observations)
+{
+    threadPool.parallelFor(envCount(), [&](int begin, int end)
+    {
+        for (int i = begin; i < end; i++)
+        {
+            this->seeds[i] = seeds[i];
+            episodeSteps[i] = 0;
+            worlds[i]->reset(seeds[i]);
+            observe(i, observations + i * observationSize);
+        }
+    }, 16);
+}
+
+void VecEnv::step(const std::uint8_t* actions, float* observations, float* rewards, std::uint8_t* done)
+{
+    threadPool.parallelFor(envCount(), [&](int begin, int end)
+    {
+        for (int i = begin; i < end; i++)
+        {
+            World& world = *worlds[i];
+            std::uint8_t action = actions[i];
+
+            float scoreBefore = world.score;
+            world.step(action & ACTION_LEFT, action & ACTION_RIGHT, action & ACTION_UP, action & ACTION_DOWN, deltaTime);
+            rewards[i] = world.score - scoreBefore;
+
+            bool finished = world.gameOver || (maxEpisodeSteps > 0 && ++episodeSteps[i] >= maxEpisodeSteps);
+            done[i] = finished;
+
+            // Start the next episode of this environment
+            if (finished)
+            {
+                seeds[i] = seeds[i] * 6364136223846793005ull + 1442695040888963407ull;
+                episodeSteps[i] = 0;
+                world.reset(seeds[i]);
+            }
+
+            observe(i, observations + i * observationSize);
+        }
+    }, 16);
+}
+
+// Write the observation of a single environment, positions and velocities are scaled to roughly [-1, 1]
+// * Observations are always float, the (float) casts only matter in the fixed point mode
+void VecEnv::observe(int index, float* observation)
+{
+    World& world = *worlds[index];
+    Player& player = *world.bodies.player;
+
+    float invWidth = 1.0f / (float)world.windowSize.x;
+    float invHeight = 1.0f / (float)world.windowSize.y;
+    float invPlayerMaxVel = 1.0f / world.settings.playerMaxVel;
+    float invCarMaxVel = 1.0f / carMaxVelLimit();
+
+    observation[0] = (float)player.pos.x * invWidth;
+    observation[1] = (float)player.vel.x * invPlayerMaxVel;
+    observation[2] = (float)player.vel.y * invPlayerMaxVel;
+    observation[3] = (float)player.health / player.maxHealth;
+    observation[4] = player.intangible ? 1.0f : 0.0f;
+
+    // Keep the nearest cars (insertion into a small sorted array)
+    Car* nearest[observedCars] = {};
+    float nearestDist[observedCars];
+    int found = 0;
+
+    for (Car* car : world.bodies.cars)
+    {
+        float dist = (float)(car->pos - player.pos).sqrMagnitude();
+        int slot = found < observedCars ? found++ : observedCars;
+        while (slot > 0 && nearestDist[slot - 1] > dist)
+        {
+            if (slot < observedCars) { nearest[slot] = nearest[slot - 1]; nearestDist[slot] = nearestDist[slot - 1]; }
+            slot--;
+        }
+        if (slot < observedCars) { nearest[slot] = car; nearestDist[slot] = dist; }
+    }
+
+    float* carObservation = observation + 5;
+    for (int i = 0; i < observedCars; i++, carObservation += 4)
+    {
+        if (i < found)
+        {
+            carObservation[0] = (float)(nearest[i]->pos.x - player.pos.x) * invWidth;
+            carObservation[1] = (float)(nearest[i]->pos.y - player.pos.y) * invHeight;
+            carObservation[2] = (float)nearest[i]->vel.x * invCarMaxVel;
+            carObservation[3] = (float)nearest[i]->vel.y * invCarMaxVel;
+        }
+        // Missing cars are reported far away
+        else { carObservation[0] = 0.0f; carObservation[1] = -1.0f; carObservation[2] = 0.0f; carObservation[3] = 0.0f; }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "world.h"
+#include "threadPool.h"
+
+// Owns N independent game instances and steps them in parallel for batch agents
+// * All buffers are contiguous and indexed [environment][value]
+// * An environment that is done is reset right away (with the next seed of its sequence),
+//   so the observation returned with done = 1 is already the first one of the new episode
+class VecEnv
+{
+    public:
+        // Amount of cars (nearest to the player) that are part of an observation
+        static constexpr int observedCars = 4;
+        // player (x, y velocity, health, intangible) + per car (relative position, velocity)
+        static constexpr int observationSize = 5 + observedCars * 4;
+
+        VecEnv(int envCount, const WorldSettings& settings = WorldSettings{}, Vector2 windowSize = Vector2{750.0f, 1250.0f},
+            float deltaTime = 1.0f / 60.0f, int maxEpisodeSteps = 60 * 60 * 5, int threadCount = -1);
+        ~VecEnv();
+
+        int envCount() const;
+
+        // seeds[envCount], observations[envCount * observationSize]
+        void reset(const std::uint64_t* seeds, float* observations);
+        // actions[envCount], observations[envCount * observationSize], rewards[envCount], done[envCount]
+        void step(const std::uint8_t* actions, float* observations, float* rewards, std::uint8_t* done);
+
+        World& world(int index);
+
+    private:
+        std::vector<World*> worlds;
+        std::vector<std::uint64_t> seeds;
+        std::vector<int> episodeSteps;
+        ThreadPool threadPool;
+        float deltaTime;
+        int maxEpisodeSteps;
+
+        void observe(int index, float* observation);
+};
\ No newline at end of file
@@ -1,109 +1,137 @@
 #include "vector2.h"
 #include "myMathLib.h"
 
-Vector2::Vector2(float x, float y) : x(x), y(y) {};
-Vector2::Vector2(float x) : x(x), y(x) {};
-Vector2::Vector2() : x(0.0f), y(0.0f) {};
-Vector2::~Vector2() = default;
-Vector2::Vector2(const Vector2& other) = default;
-
-float Vector2::magnitude()
+template <class T>
+Vector2T<T>::Vector2T(T x, T y) : x(x), y(y) {};
+template <class T>
+Vector2T<T>::Vector2T(T x) : x(x), y(x) {};
+template <class T>
+Vector2T<T>::Vector2T() : x(0.0f), y(0.0f) {};
+
+template <class T>
+T Vector2T<T>::magnitude() const
 {
     return MyMathLib::sqrt(x * x + y * y);
 }
 
-Vector2 Vector2::clampMagnitude(float mag) { return normalized() * mag; }
+template <class T>
+Vector2T<T> Vector2T<T>::clampMagnitude(T mag) const { return normalized() * mag; }
 
-float Vector2::sqrMagnitude() { return x * x + y * y; }
+template <class T>
+T Vector2T<T>::sqrMagnitude() const { return x * x + y * y; }
 
-Vector2 Vector2::normalized()
+template <class T>
+Vector2T<T> Vector2T<T>::normalized() const
 {
-    float mag = magnitude();
-    if (mag == 0.0f) { mag = 1.0f; }
+    T mag = magnitude();
+    if (mag == 0.0f) { mag = T(1.0f); }
     return {x / mag, y / mag};
 }
 
-void Vector2::normalize()
+template <class T>
+void Vector2T<T>::normalize()
 {
-    float mag = magnitude();
-    if (mag == 0.0f) { mag = 1.0f; }
+    T mag = magnitude();
+    if (mag == 0.0f) { mag = T(1.0f); }
     x /= mag, y /= mag;
 }
 
-float Vector2::dot(Vector2& other) { return Vector2::dot(*this, other); }
-float Vector2::distance(Vector2& other) { return Vector2::distance(*this, other); }
-
-float Vector2::dot(Vector2& a, Vector2& b) { return a.x * b.x + a.y * b.y; }
-float Vector2::distance(Vector2& a, Vector2& b) { return (b - a).magnitude(); }
-
-Vector2 Vector2::operator+(const float& other) const { return {x + other, y + other}; };
-Vector2 Vector2::operator-(const float& other) const { return {x - other, y - other}; };
-Vector2 Vector2::operator/(const float& other) const { return {x / other, y / other}; };
-Vector2 Vector2::operator*(const float& other) const { return {x * other, y * other}; };
-
-Vector2& Vector2::operator+=(const float& other)
+template <class T>
+T Vector2T<T>::dot(Vector2T<T>& other) { return Vector2T<T>::dot(*this, other); }
+template <class T>
+T Vector2T<T>::distance(Vector2T<T>& other) { return Vector2T<T>::distance(*this, other); }
+
+template <class T>
+T Vector2T<T>::dot(Vector2T<T>& a, Vector2T<T>& b) { return a.x * b.x + a.y * b.y; }
+template <class T>
+T Vector2T<T>::distance(Vector2T<T>& a, Vector2T<T>& b) { return (b - a).magnitude(); }
+
+template <class T>
+Vector2T<T> Vector2T<T>::operator+(const T& other) const { return {x + other, y + other}; };
+template <class T>
+Vector2T<T> Vector2T<T>::operator-(const T& other) const { return {x - other, y - other}; };
+template <class T>
+Vector2T<T> Vector2T<T>::operator/(const T& other) const { return {x / other, y / other}; };
+template <class T>
+Vector2T<T> Vector2T<T>::operator*(const T& other) const { return {x * other, y * other}; };
+
+template <class T>
+Vector2T<T>& Vector2T<T>::operator+=(const T& other)
 {
     x += other, y += other;
     return *this;
 };
 
-Vector2& Vector2::operator-=(const float& other)
+template <class T>
+Vector2T<T>& Vector2T<T>::operator-=(const T& other)
 {
     x -= other, y -= other;
     return *this;
 };
 
-Vector2& Vector2::operator*=(const float& other)
+template <class T>
+Vector2T<T>& Vector2T<T>::operator*=(const T& other)
 {
     x *= other, y *= other;
     return *this;
 };
 
-Vector2& Vector2::operator/=(const float& other)
+template <class T>
+Vector2T<T>& Vector2T<T>::operator/=(const T& other)
 {
     x /= other, y /= other;
     return *this;
 };
 
-Vector2& Vector2::operator=(const Vector2& other)
-{
-    if (*this != other) { x = other.x; y = other.y; }
-    return *this;
-};
-
-Vector2 Vector2::operator+(const Vector2& other) const { return {x + other.x, y + other.y}; };
-Vector2 Vector2::operator-(const Vector2& other) const { return {x - other.x, y - other.y}; };
-Vector2 Vector2::operator/(const Vector2& other) const { return {x / other.x, y / other.y}; };
-Vector2 Vector2::operator*(const Vector2& other) const { return {x * other.x, y * other.y}; };
-
-Vector2& Vector2::operator+=(const Vector2& other)
+template <class T>
+Vector2T<T> Vector2T<T>::operator+(const Vector2T<T>& other) const { return {x + other.x, y + other.y}; };
+template <class T>
+Vector2T<T> Vector2T<T>::operator-(const Vector2T<T>& other) const { return {x - other.x, y - other.y}; };
+template <class T>
+Vector2T<T> Vector2T<T>::operator/(const Vector2T<T>& other) const { return {x / other.x, y / other.y}; };
+template <class T>
+Vector2T<T> Vector2T<T>::operator*(const Vector2T<T>& other) const { return {x * other.x, y * other.y}; };
+
+template <class T>
+Vector2T<T>& Vector2T<T>::operator+=(const Vector2T<T>& other)
 {
     x += other.x, y += other.y;
     return *this;
 };
 
-Vector2& Vector2::operator-=(const Vector2& other)
+template <class T>
+Vector2T<T>& Vector2T<T>::operator-=(const Vector2T<T>& other)
 {
     x -= other.x, y -= other.y;
     return *this;
 };
 
-Vector2& Vector2::operator/=(const Vector2& other)
+template <class T>
+Vector2T<T>& Vector2T<T>::operator/=(const Vector2T<T>& other)
 {
     x /= other.x, y /= other.y;
     return *this;
 };
 
-Vector2& Vector2::operator*=(const Vector2& other)
+template <class T>
+Vector2T<T>& Vector2T<T>::operator*=(const Vector2T<T>& other)
 {
     x *= other.x, y *= other.y;
     return *this;
 };
 
-bool Vector2::operator==(const Vector2& other) const { return x == other.x && y == other.y; };
-bool Vector2::operator!=(const Vector2& other) const { return x != other.x || y != other.y; };
+template <class T>
+bool Vector2T<T>::operator==(const Vector2T<T>& other) const { return x == other.x && y == other.y; };
+template <class T>
+bool Vector2T<T>::operator!=(const Vector2T<T>& other) const { return x != other.x || y != other.y; };
 
-std::ostream& operator<<(std::ostream& os, const Vector2& vec2)
+template <class T>
+std::ostream& operator<<(std::ostream& os, const Vector2T<T>& vec2)
 {
-    return os << "vector2 [" << vec2.x << ", " << vec2.y << "]";
+    return os << "vector2 [" << (float)vec2.x << ", " << (float)vec2.y << "]";
 };
+
+template class Vector2T<float>;
+template class Vector2T<Fixed>;
+template std::ostream& operator<<(std::ostream& os, const Vector2T<float>& vec2);
+template std::ostream& operator<<(std::ostream& os, const Vector2T<Fixed>& vec2);
\ No newline at end of file
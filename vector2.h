@@ -1,55 +1,65 @@
 #pragma once
 
 #include <iostream>
+#include "fixed.h"
 
-class Vector2
+// 2D vector of any scalar type (float or Fixed), the game uses Vector2 (see Scalar in fixed.h)
+// * Only instantiated for float and Fixed (see the end of vector2.cpp)
+template <class T>
+class Vector2T
 {
     public:
-        float x;
-        float y;
-
-        Vector2(float x, float y);
-        Vector2(float x);
-        Vector2();
-        ~Vector2();
-        Vector2(const Vector2& other);
+        T x;
+        T y;
+
+        Vector2T(T x, T y);
+        Vector2T(T x);
+        Vector2T();
+        // From other numbers (float constants in fixed point builds), converting has to be spelled out
+        template <class U, IfArithmetic<U> = 0, typename std::enable_if<!std::is_same<T, U>::value, int>::type = 0>
+        explicit Vector2T(U x, U y) : x(T(x)), y(T(y)) {}
+        ~Vector2T() = default;
+        Vector2T(const Vector2T& other) = default;
         
-        float magnitude();
-        Vector2 clampMagnitude(float mag);
-        float sqrMagnitude();
-        Vector2 normalized();
+        T magnitude() const;
+        Vector2T clampMagnitude(T mag) const;
+        T sqrMagnitude() const;
+        Vector2T normalized() const;
 
         void normalize();
 
-        float dot(Vector2& other);
-        float distance(Vector2& other);
+        T dot(Vector2T& other);
+        T distance(Vector2T& other);
 
-        static float dot(Vector2& a, Vector2& b);
-        static float distance(Vector2& a, Vector2& b);
+        static T dot(Vector2T& a, Vector2T& b);
+        static T distance(Vector2T& a, Vector2T& b);
 
-        Vector2 operator+(const float& other) const;
-        Vector2 operator-(const float& other) const;
-        Vector2 operator/(const float& other) const;
-        Vector2 operator*(const float& other) const;
+        Vector2T operator+(const T& other) const;
+        Vector2T operator-(const T& other) const;
+        Vector2T operator/(const T& other) const;
+        Vector2T operator*(const T& other) const;
 
-        Vector2& operator+=(const float& other);
-        Vector2& operator-=(const float& other);
-        Vector2& operator*=(const float& other);
-        Vector2& operator/=(const float& other);
-        Vector2& operator=(const Vector2& other);
+        Vector2T& operator+=(const T& other);
+        Vector2T& operator-=(const T& other);
+        Vector2T& operator*=(const T& other);
+        Vector2T& operator/=(const T& other);
+        Vector2T& operator=(const Vector2T& other) = default;
         
-        Vector2 operator+(const Vector2& other) const;
-        Vector2 operator-(const Vector2& other) const;
-        Vector2 operator/(const Vector2& other) const;
-        Vector2 operator*(const Vector2& other) const;
+        Vector2T operator+(const Vector2T& other) const;
+        Vector2T operator-(const Vector2T& other) const;
+        Vector2T operator/(const Vector2T& other) const;
+        Vector2T operator*(const Vector2T& other) const;
         
-        Vector2& operator+=(const Vector2& other);
-        Vector2& operator-=(const Vector2& other);
-        Vector2& operator/=(const Vector2& other);
-        Vector2& operator*=(const Vector2& other);
+        Vector2T& operator+=(const Vector2T& other);
+        Vector2T& operator-=(const Vector2T& other);
+        Vector2T& operator/=(const Vector2T& other);
+        Vector2T& operator*=(const Vector2T& other);
+
+        bool operator==(const Vector2T& other) const;
+        bool operator!=(const Vector2T& other) const;
+};
 
-        bool operator==(const Vector2& other) const;
-        bool operator!=(const Vector2& other) const;
+template <class T>
+std::ostream& operator<<(std::ostream& os, const Vector2T<T>& vec);
 
-        friend std::ostream& operator<<(std::ostream& os, const Vector2& vec);
-};
\ No newline at end of file
+using Vector2 = Vector2T<Scalar>;
\ No newline at end of file
@@ -0,0 +1,356 @@
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include "world.h"
+
+static_assert(std::is_trivially_copyable<WorldSnapshot>::value, "WorldSnapshot has to be copyable with memcpy");
+
+std::size_t WorldSnapshot::usedSize() const { return offsetof(WorldSnapshot, bodies) + bodyCount * sizeof(BodyState); }
+
+void WorldSnapshot::copyTo(WorldSnapshot& other) const { std::memcpy(&other, this, usedSize()); }
+
+World::World(const WorldSettings& settings, Vector2 windowSize, BodyType playerType, std::vector<BodyType> carTypes) :
+    settings(settings), windowSize(windowSize), playerType(playerType), carTypes(carTypes)
+{
+    // Archetypes without a given texture run headless
+    for (int i = (int)this->carTypes.size(); i < carArchetypeCount; i++) { this->carTypes.push_back({carArchetypes[i].width, carArchetypes[i].height}); }
+
+    lanes.configure(settings.roadMarkingLineAmount + 1, (float)windowSize.x);
+    reset(0);
+}
+
+World headlessWorld(const WorldSettings& settings, Vector2 windowSize) { return World{settings, windowSize, BodyType{44, 100}, {}}; }
+
+World::~World()
+{
+    for (Car* car : bodies.cars) { delete car; }
+    for (Car* car : carPool) { ::operator delete(car); }
+    delete bodies.player;
+}
+
+// * Remove RigidBody Objects //
+// The cars go back to the pool, the player is reused by playerInitializer()
+void World::clear()
+{
+    for (Car* car : bodies.cars) { releaseCar(car); }
+    bodies.cars.clear();
+}
+
+// * Car pool //
+// Memory of a pooled car (or new memory), the caller constructs the car in it and adds it to the cars
+Car* World::acquireCar()
+{
+    if (carPool.empty()) { return static_cast<Car*>(::operator new(sizeof(Car))); }
+    Car* memory = carPool.back();
+    carPool.pop_back();
+    return memory;
+}
+
+void World::reserveCars(int count)
+{
+    bodies.cars.reserve(count);
+    carPool.reserve(count);
+    // Every car can die once per step, and the player can be hit once
+    stepEvents.reserve(count + 1);
+    deadCars.reserve(count);
+    for (int i = carCapacity(); i < count; i++) { carPool.push_back(static_cast<Car*>(::operator new(sizeof(Car)))); }
+    lanes.reserve(count);
+}
+
+int World::carCapacity() const { return (int)(bodies.cars.size() + carPool.size()); }
+
+// Destroys the car and moves its memory to the pool, the caller takes it out of the cars
+void World::releaseCar(Car* car)
+{
+    lanes.remove(*car);
+    car->~Car();
+    carPool.push_back(car);
+}
+
+// * Car spawn timer //
+void World::scheduleCarSpawn(float seconds)
+{
+    std::uint64_t ticks = ticksFor(seconds, RigidBody::tickRate);
+    carSpawnDue = false;
+    carsSpawnDeadline = timers.now() + (ticks > 0 ? ticks : 1);
+    carsSpawnTimer = timers.schedule(ticks, &World::onCarSpawnTimer, this);
+}
+
+void World::onCarSpawnTimer(void* world) { static_cast<World*>(world)->carSpawnDue = true; }
+
+// Start a new game with the given seed
+void World::reset(std::uint64_t seed)
+{
+    clear();
+    random.seed(seed);
+    timers.clear(0);
+    pendingTicks = 0.0;
+
+    idCounter = 0;
+    score = 0.0f;
+    carsDodged = 0;
+    gameOver = false;
+
+    carsMaxAmount = settings.carsStartMaxAmount;
+    carsAmount = 0;
+    scheduleCarSpawn(settings.carsMaxSpawnTime);
+    cameraPosition = Vector2{};
+    events.push({WorldEvent::Type::GAME_STARTED, 0, Vector2{}});
+
+    playerInitializer();
+
+    // Spawn Cars
+    for (int i = 0; i < settings.carsStartAmount; i++) { carInitializer(Scalar{settings.cameraVerticalOffset}); }
+}
+
+
+// * Rigidbody initializers //
+void World::playerInitializer()
+{
+    int leewayWidth = playerType.mask == nullptr ? settings.hurtboxLeewayWidth : 0;
+    int leewayHeight = playerType.mask == nullptr ? settings.hurtboxLeewayHeight : 0;
+
+    // A reset reuses the memory of the old player
+    void* memory = bodies.player;
+    if (bodies.player != nullptr) { bodies.player->~Player(); }
+    else { memory = ::operator new(sizeof(Player)); }
+
+    Player* player = new (memory) Player{idCounter++, playerType.width - leewayWidth, playerType.height - leewayHeight,
+        settings.playerMaxVel, settings.playerForceAmount, settings.playerFrictionCoefficient, settings.playerMass,
+        settings.maxHealth, settings.maxIntangibleTime};
+
+    settings.collisionMatrix.apply(*player);
+    player->sprite = playerType.texture.sprite();
+    player->pixelMask = playerType.mask;
+    player->timers = &timers;
+    player->setPosition(Vector2{windowSize.x * 0.5f, Scalar{0.0f}});
+
+    bodies.player = player;
+}
+
+void World::carInitializer(Scalar cameraVerticalPos)
+{
+    // Randomize car type / texture, by the spawn weights of the archetypes
+    int typeIndex = carArchetypeForRoll(random.range(carSpawnWeightTotal()));
+    const BodyType& carType = carTypes[typeIndex];
+
+    // Get dimensions
+    int width = carArchetypes[typeIndex].width;
+    int halfWidth = width / 2;
+    int height = carArchetypes[typeIndex].height;
+
+    // Randomize variables
+    float forceAmountPerFrame = random.range(settings.carForceAmountMin, settings.carForceAmountMax);
+    float horizontalMultiplier = random.range(settings.horizontalMultiplierMin, settings.horizontalMultiplierMax);
+    float verticalSpawnLocation = random.range(settings.verticalSpawnLocationMin, settings.verticalSpawnLocationMax);
+
+    // Initialize Car at the back of the cars
+    Car* car = new (acquireCar()) Car{idCounter++, typeIndex, forceAmountPerFrame, horizontalMultiplier, random.chance()};
+    bodies.cars.push_back(car);
+    settings.collisionMatrix.apply(*car);
+    car->sprite = carType.texture.sprite();
+    car->pixelMask = carType.mask;
+    // Randomize spawn position
+    car->setPosition(Vector2{Scalar{random.range(0.0f, (float)(windowSize.x - width)) + halfWidth}, -height * 0.5f - verticalSpawnLocation + cameraVerticalPos});
+    lanes.insert(*car);
+
+    carsAmount++;
+}
+
+
+void World::step(bool left, bool right, bool up, bool down, float deltaTime)
+{
+    if (gameOver) { return; }
+
+    Player* player = bodies.player;
+
+    // Increase difficulty by the amount traveled, this increases the maximum amount of cars
+    carsMaxAmount = settings.carsMaxAmountAt((float)-player->pos.y);
+
+    // Score counter (carsDodged + amountTraveled)
+    score = (float)(carsDodged * settings.scoreForDodging + -player->pos.y * settings.scoreForTravel);
+
+    // Get cameraPosition
+    cameraPosition.y = player->pos.y + settings.cameraVerticalOffset;
+
+
+    // * Timers //
+    // The time of the step in whole ticks, the rest carries over to the next step
+    pendingTicks += (double)deltaTime * RigidBody::tickRate;
+    std::uint64_t ticks = (std::uint64_t)pendingTicks;
+    pendingTicks -= (double)ticks;
+    timers.advance(ticks);
+
+
+    // * Spawn cars //
+    // A due spawn waits for a free place, the next one is sooner the more places there are
+    if (carSpawnDue && carsAmount < carsMaxAmount)
+    {
+        carInitializer(cameraPosition.y);
+        scheduleCarSpawn(settings.carsMaxSpawnTime / MyMathLib::max(carsMaxAmount - carsAmount, 1));
+    }
+
+
+    // * Update rigidBody objects //
+    // A dead car leaves the lanes right away, it stays in the cars until the end of the step,
+    // intangible so the bodies after it don't collide with it
+    for (int i = 0; i < (int)bodies.cars.size(); i++)
+    {
+        Car& car = *bodies.cars[i];
+        if (settings.carsAvoidTraffic) { car.avoidTraffic(lanes, settings.carBrakingDistance); }
+
+        if (car.update(bodies, windowSize, cameraPosition, deltaTime)) { lanes.moved(car); continue; }
+
+        car.intangible = true;
+        lanes.remove(car);
+        deadCars.push_back(i);
+        stepEvents.push_back({WorldEvent::Type::CAR_DODGED, car.id, car.pos});
+    }
+
+
+    // * Update Player //
+    player->movementLogic(left, right, up, down, deltaTime);
+
+    // If player gets hit
+    if (player->update(bodies, windowSize, cameraPosition, deltaTime))
+    {
+        player->hit = false; // Reset the hit boolean
+        stepEvents.push_back({WorldEvent::Type::PLAYER_HIT, player->id, player->pos});
+    }
+
+
+    // * End of step //
+    applyEvents();
+    removeDeadCars();
+}
+
+// Applies what happened during the step, then hands it to the sounds and the particles
+void World::applyEvents()
+{
+    for (const WorldEvent& event : stepEvents)
+    {
+        switch (event.type)
+        {
+            case WorldEvent::Type::CAR_DODGED:
+                // The score is recomputed at the start of every step, this keeps it up to date until then
+                score += settings.scoreForDodging;
+                carsAmount--;
+                carsDodged++;
+                break;
+            case WorldEvent::Type::PLAYER_HIT:
+                gameOver = bodies.player->health <= 0;
+                break;
+            default:
+                break;
+        }
+        events.push(event);
+    }
+    stepEvents.clear();
+}
+
+// From the highest index down, so the last car that takes a dead car's place is never dead itself
+// * Costs one swap per dead car, however many cars there are
+void World::removeDeadCars()
+{
+    for (int i = (int)deadCars.size() - 1; i >= 0; i--)
+    {
+        Car* car = bodies.cars[deadCars[i]];
+        events.push({WorldEvent::Type::CAR_DESPAWNED, car->id, car->pos});
+        releaseCar(car);
+
+        bodies.cars[deadCars[i]] = bodies.cars.back();
+        bodies.cars.pop_back();
+    }
+    deadCars.clear();
+}
+
+// Draw the cars, then the player on top
+void World::draw(RenderSurface& surface)
+{
+    for (Car* car : bodies.cars) { car->draw(surface, cameraPosition); }
+    bodies.player->draw(surface, cameraPosition);
+}
+
+
+// * Snapshots //
+bool World::save(WorldSnapshot& snapshot) const
+{
+    if (1 + (int)bodies.cars.size() > WorldSnapshot::maxBodies) { return false; }
+
+    snapshot.random = random;
+    snapshot.cameraPosition = cameraPosition;
+    snapshot.score = score;
+    snapshot.carsDodged = carsDodged;
+    snapshot.gameOver = gameOver;
+
+    snapshot.idCounter = idCounter;
+    snapshot.carsMaxAmount = carsMaxAmount;
+    snapshot.carsAmount = carsAmount;
+
+    snapshot.tick = timers.now();
+    snapshot.pendingTicks = pendingTicks;
+    snapshot.carsSpawnDeadline = carsSpawnDeadline;
+
+    bodies.player->saveState(snapshot.bodies[0]);
+    snapshot.bodyCount = 1;
+    for (Car* car : bodies.cars) { car->saveState(snapshot.bodies[snapshot.bodyCount++]); }
+    return true;
+}
+
+// Existing bodies are reused where possible, so restoring a similar state does not allocate
+void World::restore(const WorldSnapshot& snapshot)
+{
+    random = snapshot.random;
+    cameraPosition = snapshot.cameraPosition;
+    score = snapshot.score;
+    carsDodged = snapshot.carsDodged;
+    gameOver = snapshot.gameOver;
+
+    idCounter = snapshot.idCounter;
+    carsMaxAmount = snapshot.carsMaxAmount;
+    carsAmount = snapshot.carsAmount;
+
+    // Back to the time of the snapshot, the player schedules its own timer when its state is loaded
+    timers.clear(snapshot.tick);
+    pendingTicks = snapshot.pendingTicks;
+    carsSpawnDeadline = snapshot.carsSpawnDeadline;
+    carSpawnDue = carsSpawnDeadline <= snapshot.tick;
+    if (!carSpawnDue) { carsSpawnTimer = timers.schedule(carsSpawnDeadline - snapshot.tick, &World::onCarSpawnTimer, this); }
+
+    bodies.player->loadState(snapshot.bodies[0]);
+
+    // Remove the cars that are not in the snapshot
+    int carCount = snapshot.bodyCount - 1;
+    while ((int)bodies.cars.size() > carCount)
+    {
+        releaseCar(bodies.cars.back());
+        bodies.cars.pop_back();
+    }
+
+    for (int i = 0; i < carCount; i++)
+    {
+        const BodyState& state = snapshot.bodies[i + 1];
+
+        if (i == (int)bodies.cars.size()) { carInitializer(state); }
+
+        // Swap the sprite and mask when the car changes type
+        Car& car = *bodies.cars[i];
+        car.loadState(state);
+        car.sprite = carTypes[state.typeIndex].texture.sprite();
+        car.pixelMask = carTypes[state.typeIndex].mask;
+    }
+
+    lanes.rebuild(bodies.cars);
+}
+
+// Creates a car for the given state at the back of the cars, the state itself is loaded by the caller
+Car* World::carInitializer(const BodyState& state)
+{
+    Car* car = new (acquireCar()) Car{state.id, state.typeIndex, (float)state.forceAmountPerFrame, state.horizontalMultiplier, state.horizontalDir};
+
+    settings.collisionMatrix.apply(*car);
+    car->sprite = carTypes[state.typeIndex].texture.sprite();
+    car->pixelMask = carTypes[state.typeIndex].mask;
+    bodies.cars.push_back(car);
+    return car;
+}
\ No newline at end of file
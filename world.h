@@ -0,0 +1,232 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+#include "vector2.h"
+#include "random.h"
+#include "rigidBody.h"
+#include "player.h"
+#include "car.h"
+#include "bodyGroups.h"
+#include "collisionMatrix.h"
+#include "laneIndex.h"
+#include "worldEvents.h"
+#include "timerWheel.h"
+#include "resourceManager.h"
+
+// Gameplay values of a game instance, the defaults are the values of the original game
+struct WorldSettings
+{
+    // Values that get added to the player's score for specific conditions
+    float scoreForTravel = 0.01f;
+    float scoreForDodging = 10.0f;
+
+    // The score the player needs to obtain to win the game
+    float winCondition = 1000.0f;
+
+    // The amount of distance it takes to increase the maximum car amount (Difficulty increase over time)
+    float diffIncrDistance = 5000.0f;
+
+    // The vertical offset of the camera from the player
+    float cameraVerticalOffset = -1150.0f;
+
+
+    // * Player Variables //
+    // decrease the player's hurtbox size (hurtbox is normally the same size as the given texture)
+    // * Not used when the player has a pixel mask, the mask already leaves out the transparent corners
+    int hurtboxLeewayWidth = 8;
+    int hurtboxLeewayHeight = 8;
+
+    // Player speed
+    float playerForceAmount = 750.0f;
+    // The intensity of the friction the player receives
+    float playerFrictionCoefficient = 1.0f;
+    float playerMaxVel = 1500.0f;
+    float playerMass = 100.0f;
+    int maxHealth = 3;
+    float maxIntangibleTime = 3.0f;
+
+
+    // * Car Variables //
+    // The max velocity, mass and friction of a car come from its archetype (see carArchetypes.h)
+
+    // Min and Max of Horizontal and Vertical Speed of a car
+    float carForceAmountMin = 50.0f;
+    float carForceAmountMax = 400.0f;
+
+    // Min and Max of the horizontal multiplier (horizontalForce = forceAmount * horizontalMultiplier)
+    float horizontalMultiplierMin = 0.0f;
+    float horizontalMultiplierMax = 1.5f;
+
+    // Min and Max of the vertical spawn location of the cars
+    // (0.0f is the top of the game window, higher numbers will have the car spawn higher above the game window)
+    float verticalSpawnLocationMin = 0.0f;
+    float verticalSpawnLocationMax = 0.0f;
+
+    // Maximum amount of cars that can exist at the start
+    int carsStartMaxAmount = 3;
+    // The amount of cars that spawn at the start of the game
+    int carsStartAmount = 2;
+
+    // The max amount of time it takes for a car to spawn whenever carsAmount < carsMaxAmount
+    float carsMaxSpawnTime = 3.0f;
+
+
+    // * Traffic //
+    // The road is split into roadMarkingLineAmount + 1 lanes
+    int roadMarkingLineAmount = 5;
+    // Cars brake behind a slower car in their lane that is closer than this, and steer towards a free lane
+    // * Off by default, the cars of the original game drive straight through each other
+    bool carsAvoidTraffic = false;
+    float carBrakingDistance = 120.0f;
+
+
+    // * Collisions //
+    // Which factions react to touching each other, pairs that don't are never tested
+    CollisionMatrix collisionMatrix;
+
+
+    // The max amount of cars once the player traveled distance
+    int carsMaxAmountAt(float distance) const { return carsStartMaxAmount + (int)(distance / diffIncrDistance); }
+    // The max amount of cars when the score for travel alone reaches the win condition, what World::reserveCars needs
+    // for every game that doesn't go on far past winning
+    int carsMaxAmountToWin() const { return carsMaxAmountAt(winCondition / scoreForTravel); }
+};
+
+// Bits of the held inputs (A/D/W/S), one byte per player input
+enum ActionBit : std::uint8_t { ACTION_LEFT = 1, ACTION_RIGHT = 2, ACTION_UP = 4, ACTION_DOWN = 8 };
+
+// The size of a body type and its texture (empty when running without a window)
+// * Bodies with a mask collide pixel accurately, bodies without one collide as boxes
+struct BodyType
+{
+    int width;
+    int height;
+    TextureHandle texture{};
+    const PixelMask* mask = nullptr;    // Usually the texture's, kept alive by whoever owns the texture
+};
+
+// Plain data copy of everything that changes during a game, so saving, restoring and copying it is cheap
+// * Used for rollback, instant restarts and looking ahead
+// * Only the first bodyCount bodies are in use, copyTo() only copies those
+struct WorldSnapshot
+{
+    static constexpr int maxBodies = 1025; // Player + 1024 cars
+
+    Random random;
+    Vector2 cameraPosition;
+    float score;
+    int carsDodged;
+    bool gameOver;
+
+    int idCounter;
+    int carsMaxAmount;
+    int carsAmount;
+
+    // The timers are saved as their deadlines, restoring schedules them again
+    std::uint64_t tick;
+    double pendingTicks;
+    std::uint64_t carsSpawnDeadline;
+
+    int bodyCount;
+    BodyState bodies[maxBodies];    // Player first, then the cars
+
+    std::size_t usedSize() const;
+    void copyTo(WorldSnapshot& other) const;
+};
+
+// A single game instance: player, cars, score, timers and randomizer
+// * Does not need a window, so many instances can be stepped side by side
+class World
+{
+    public:
+        // carTypes are the textures and masks of the car archetypes, in the order of carArchetypes (the missing ones are headless)
+        World(const WorldSettings& settings, Vector2 windowSize, BodyType playerType, std::vector<BodyType> carTypes);
+        ~World();
+        World(const World& other) = delete;
+        World& operator=(const World& other) = delete;
+
+        WorldSettings settings;
+        Vector2 windowSize;
+        BodyType playerType;
+        std::vector<BodyType> carTypes;
+
+        // All rigidbodies within the game, grouped by type
+        BodyGroups bodies;
+        // The cars per lane, for finding the car ahead or beside a car
+        LaneIndex lanes;
+
+        // The position of the camera, is used to convert world space to screen space
+        Vector2 cameraPosition{};
+
+        Random random;
+
+        float score = 0.0f;
+        int carsDodged = 0;
+        bool gameOver = false;
+
+        // What happened in the steps so far, the sounds and the particles follow these
+        WorldEvents events;
+
+        // The game's timers (the car spawns, the player's intangibility), ticking at RigidBody::tickRate
+        // * Only a timer that is due costs anything during a step
+        TimerWheel timers;
+
+        void reset(std::uint64_t seed);
+        void step(bool left, bool right, bool up, bool down, float deltaTime);
+        void draw(RenderSurface& surface);
+
+        // Returns false and leaves the snapshot as it was when there are more bodies than a snapshot can hold
+        bool save(WorldSnapshot& snapshot) const;
+        void restore(const WorldSnapshot& snapshot);
+
+        // Fills the car pool up to count cars, the max amount of cars keeps growing with the distance,
+        // so a pool that is only warmed up by playing allocates whenever a game gets further than before
+        void reserveCars(int count);
+        int carCapacity() const;
+
+    private:
+        // ID for identifying rigidBodies
+        int idCounter = 0;
+
+        // Maximum amount of cars that can exist
+        int carsMaxAmount = 0;
+        // The current count of cars;
+        int carsAmount = 0;
+        // Time that doesn't make up a whole tick yet
+        double pendingTicks = 0.0;
+        // A car spawns when the spawn timer is due and there are less than carsMaxAmount cars
+        std::uint64_t carsSpawnDeadline = 0;
+        TimerWheel::TimerId carsSpawnTimer;
+        bool carSpawnDue = false;
+
+        // Memory of removed cars, so spawning after warmup doesn't allocate
+        std::vector<Car*> carPool;
+
+        // What happened during the current step, applied and moved to events at the end of it
+        // * A list instead of the ring, so a step with more events than the ring holds doesn't lose any score
+        std::vector<WorldEvent> stepEvents;
+        // The indices of the cars that died during the current step, from low to high
+        std::vector<int> deadCars;
+
+        void clear();
+        void playerInitializer();
+        void carInitializer(Scalar cameraVerticalPos);
+        Car* carInitializer(const BodyState& state);
+
+        Car* acquireCar();
+        void releaseCar(Car* car);
+
+        void scheduleCarSpawn(float seconds);
+        static void onCarSpawnTimer(void* world);
+
+        // * End of step //
+        // The updates only record what happened, scoring and removing the dead cars is done once all bodies moved
+        void applyEvents();
+        void removeDeadCars();
+};
+
+// A world without textures or masks, with the window of the original game and its player texture size (VecEnv, benchmarks)
+World headlessWorld(const WorldSettings& settings = WorldSettings{}, Vector2 windowSize = Vector2{750.0f, 1250.0f});
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+
+#include "vector2.h"
+
+// Something that happened during a step of a world
+struct WorldEvent
+{
+    enum class Type : std::uint8_t
+    {
+        GAME_STARTED,   // reset() was called
+        PLAYER_HIT,     // The player lost health
+        CAR_DODGED,     // A car left the road behind the player, it is scored at the end of the step
+        CAR_DESPAWNED   // A car was removed at the end of the step, its id isn't used anymore
+    };
+
+    Type type;
+    int bodyId;         // The car, or the player
+    Vector2 position;   // Where the body was
+};
+
+// * World events //
+// The events of a world in order, kept in a fixed ring so recording them never allocates
+// * The world applies a step's events from its own list before they get here (see World::applyEvents),
+//   so a reader falling behind only misses sounds and particles
+// * Every event has a sequence number, readers keep the number of the next event they want (a cursor),
+//   so any amount of readers can follow a world without taking events away from each other
+// * Only the last capacity events are kept, a reader that falls further behind skips the oldest
+// ! Not part of the snapshots, restoring a world doesn't take back its events
+class WorldEvents
+{
+    public:
+        static constexpr int capacity = 256;
+
+        void push(const WorldEvent& event) { events[written % capacity] = event; written++; }
+
+        // The sequence number the next event will get
+        std::uint64_t end() const { return written; }
+
+        // Calls f with every event from cursor on, returns the cursor to continue from
+        template <class F>
+        std::uint64_t read(std::uint64_t cursor, F&& f) const
+        {
+            if (cursor > written) { cursor = written; }
+            if (written - cursor > capacity) { cursor = written - capacity; }
+            for (; cursor < written; cursor++) { f(events[cursor % capacity]); }
+            return cursor;
+        }
+
+    private:
+        WorldEvent events[capacity];
+        std::uint64_t written = 0;
+};
\ No newline at end of file